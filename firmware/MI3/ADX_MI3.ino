@@ -16,6 +16,7 @@
 // ee.h         - a simple EEPROM lib
 // oled.h       - an OLED display lib
 // font.h       - a font that I designed
+// font2x.h     - font.h at double height (tools/fontgen.cpp)
 // si5351.h     - by Milldrum and Myers
 //
 // Arduino IDE settings
@@ -70,11 +71,22 @@
 #define VBATT    20      // ADC6  battery voltage    (pin 19)
 #define BUTTON    4      // PD4   UI pushbutton      (pin  2)
 
+// direct port writes for T/R switching
+#define TXLED_ON    PORTD |=  _BV(5)   // PD5
+#define TXLED_OFF   PORTD &= ~_BV(5)
+#define RXGATE_ON   PORTB |=  _BV(0)   // PB0
+#define RXGATE_OFF  PORTB &= ~_BV(0)
+
+// T/R guard times (us)
+#define TX_GUARD  0    // Rx gate off to Tx clock on
+#define RX_GUARD  0    // Rx clock on to Rx gate on
+
 #include "i2c.h"
 #include "ee.h"
 #include "oled.h"
 #include "font.h"
 #include "si5351.h"
+#include "presets.h"
 
 // generic
 #define OFF      0
@@ -93,11 +105,10 @@
 
 // string prototype defs
 char getc();
-char gnac();
-void getsemi();
 char gcal(char ch);
 uint8_t len(char *str);
 void send(char *str);
+uint8_t cat_frame(char *cmd);
 uint8_t cmpstr(char *dst, char *src);
 void catstr(char *dst, char c);
 void uppercase(char *str);
@@ -112,6 +123,8 @@ void show_help();
 void show_cal();
 void show_info();
 void show_debug();
+void show_shadow();
+void show_stats();
 void show_queue();
 void show_band(char* str);
 void wait_ms(uint16_t dly);
@@ -119,29 +132,50 @@ void wait_us(uint16_t dly);
 void blinkLED();
 void error_blink();
 void FSK_tone();
+void set_tone(uint16_t delta);
+void init_fsk();
+void end_fsk();
+void show_fsk();
+void show_math();
+uint16_t cycles();
+uint16_t fsk_divider();
+uint32_t us_timer();
+void wait_lock(uint8_t mask);
 void check_VOX();
+void tx_page_start();
+void putnum(char *dst, uint32_t val, uint8_t width);
+void show_tx_page();
+void end_tx_page();
+void show_telemetry();
 void readbuf();
 inline void CAT_VFO();
 inline void CAT_cmd();
 void save_eeprom();
 void init_VFO();
 void init_freq();
+void set_rx_freq(uint32_t freq);
+void cat_retune(uint32_t freq);
 void init_timer0();
 void init_timer1();
 void init_pins();
 void init_i2c();
 void init_uart();
 void init_oled();
+void oled_idle();
+void run_display();
+void show_overlay(char *line0, char *line1, uint16_t ms);
 void init_check();
 void init_adc();
 void read_adc();
 void set_tx_status(uint8_t x);
+void switch_clocks(uint8_t off_clk, uint8_t on_clk);
 void tuning_hdr();
 void tuning_mode();
 void manualTX();
 uint8_t check_band();
 uint8_t freq2band(uint32_t freq);
 void update_freq(uint32_t freq);
+void draw_freq();
 void check_timeout();
 void check_UI();
 void check_CAT();
@@ -149,6 +183,8 @@ void reset_xtimer();
 void refresh();
 void do_reset(uint8_t soft);
 void run_calibrate();
+void cal_cmd(char *param);
+void cal_end(char *param);
 
 // eeprom addresses
 #define DATA_ADDR    10      // calibration data
@@ -194,6 +230,9 @@ const char* band_label[] = {
 const char* mode_label[] = {
 "??? ","FT8 ","FT4 ","JS8 ","WSPR","JT65"};
 
+// FSK synthesis labels
+const char* fsk_label[] = {"MS","PLL","PP"};
+
 // calibration data
 #define CAL_DATA_INIT  64000ULL
 uint32_t cal_data = CAL_DATA_INIT;
@@ -221,6 +260,20 @@ OLED    oled;
 #define CPUXTL  1600000000ULL // CPU clock
 #define MAXCNT  64000  // max event period
 #define MAXVOX  15     // VOX timeout (ms)
+#define MAXTONE 3000   // highest audio tone (Hz)
+
+// CLK0 integer divider range for FSK_PLL/FSK_PP
+#define FSK_DIV_MIN  8
+#define FSK_DIV_MAX  (SI5351_MULTISYNTH_A_MAX & ~1)
+
+// FSK synthesis modes
+#define FSK_MS     0   // tone steps via the CLK0 multisynth
+#define FSK_PLL    1   // tone steps via the PLLB fraction
+#define FSK_PP     2   // tones alternate between PLLA and PLLB
+#define FSK_MODES  3
+
+// default FSK synthesis mode (the FS command changes it)
+#define FSK_SYNTH  FSK_MS
 
 volatile uint8_t  d2ICR = FALSE;
 volatile uint8_t  doFSK = NO;
@@ -238,6 +291,13 @@ volatile uint16_t d2;
 #define ONE_MINUTE     60000
 #define TIMEOUT        HALF_MINUTE
 
+// CAT parser
+#define CAT_IDLE     0    // waiting for the first command letter
+#define CAT_NAME     1    // waiting for the second command letter
+#define CAT_PARAM    2    // taking parameters up to the semicolon
+#define CAT_PARAMS  20    // parameter buffer size
+#define CAT_STALE  500    // drop a CAT frame when no byte comes (ms)
+
 // user interface macros
 #define NBP  0  // no-button-pushed
 #define BSC  1  // button-single-click
@@ -257,6 +317,9 @@ uint32_t xtimer;
 // band module ID fault detected
 uint8_t band_fault;
 
+// mode/band/freq display redraw pending
+uint8_t redraw = NO;
+
 // millisecond time
 volatile uint32_t msTimer = 0;
 volatile uint16_t loopCount = 0;
@@ -283,35 +346,10 @@ ISR (TIMER1_CAPT_vect) {
 
 // read char from the serial port
 char getc() {
-  while (!Serial.available());
+  while (!Serial.available()) run_display();
   return(Serial.read());
 }
 
-// get next alpha char from serial buffer
-char gnac() {
-  char ch;
-  uint16_t tc = 0;  // for timeout
-  while (TRUE) {
-    if (Serial.available()) {
-      ch = Serial.read();
-      if (alpha(ch)) return(ch);
-    } else {
-      if (tc++ > 1024) return('z');
-    }
-  }
-}
-
-// wait for semicolon from serial buffer
-void getsemi() {
-  char ch;
-  while (TRUE) {
-    if (Serial.available()) {
-      ch = Serial.read();
-      if (ch == ';') return;
-    }
-  }
-}
-
 // get cal control char from serial buffer
 char gcal(char ch) {
   char new_ch;
@@ -339,10 +377,19 @@ uint8_t len(char *str) {
 
 // send a command
 void send(char *str) {
-  getsemi(); // get semicolon
   Serial.print(str);
 }
 
+// commands that take a frame up to the semicolon, the
+// others run as soon as both letters are in
+uint8_t cat_frame(char *cmd) {
+  char *frames = "IFIDFAAIMDPSXTTXRXCACE";
+  for (; *frames; frames+=2) {
+    if (cmpstr(cmd, frames)) return(YES);
+  }
+  return(NO);
+}
+
 // compare command
 uint8_t cmpstr(char *x, char *y) {
   if ((x[0] == y[0]) && (x[1] == y[1])) return(1);
@@ -414,11 +461,7 @@ void show_version(uint8_t x) {
   }
   if ((x == LOCAL) || (x == BOTH)) {
     // print to OLED
-    oled.clrScreen();
-    oled.printline(0, VERSION);
-    oled.printline(1, DATE);
-    wait_ms(TWO_SECONDS);
-    oled.clrScreen();
+    show_overlay(VERSION, DATE, TWO_SECONDS);
   }
 }
 
@@ -438,11 +481,18 @@ void show_version(uint8_t x) {
   II => print info\r\n\
   FR => factory reset\r\n\
   SR => soft reset\r\n\
-  CM => calibration mode\r\n\n"
+  CM => calibration mode\r\n\
+  SV => verify Si5351 regs\r\n\
+  SS => synthesizer and bus stats\r\n\
+  FS => FSK synthesis mode\r\n\
+  MB => synthesis math bench\r\n\
+  CA => cal output, CA<Hz>; calibrate\r\n\
+  CE => end cal and save, CE0; discard\r\n\
+  TP => TX telemetry page on/off\r\n\n"
 
 // print help message
 void show_help() {
-  Serial.print(HELP_MSG);
+  Serial.print(F(HELP_MSG));
 }
 
 // print calibration data
@@ -458,6 +508,64 @@ uint8_t  tx_status = RX;
 uint32_t vox_timer;
 uint32_t base_freq = 0;
 
+// FSK tone cache (most recently used first)
+#define TONE_CACHE  8
+struct ToneEntry {
+  uint16_t delta;     // captured event period
+  uint8_t  r_div;
+  struct Si5351RegSet reg;
+};
+ToneEntry tone_cache[TONE_CACHE];
+uint8_t  tone_count = 0;   // valid entries
+uint32_t tone_base;        // base_freq of the cached tones
+uint32_t tone_cal;         // cal_data of the cached tones
+uint8_t  tone_synth;       // fsk_synth of the cached tones
+uint32_t tone_hits = 0;
+uint32_t tone_miss = 0;
+
+uint8_t  fsk_synth = FSK_SYNTH;
+uint16_t fsk_div;          // CLK0 integer divider for FSK_PLL/FSK_PP
+uint8_t  fsk_pll;          // PLL driving CLK0 for FSK_PP
+uint8_t  fsk_plla = NO;    // PLLA is borrowed from Rx for FSK_PP
+uint16_t fsk_delta = 0;    // tone on the air for FSK_PP
+uint16_t fsk_idle = 0;     // tone the idle PLL holds for FSK_PP, 0 if none
+uint16_t sw_cycles = 0;    // last FSK_PP tone, load and switch until on the chip (CPU cycles)
+uint16_t sw_max = 0;       // worst FSK_PP tone (CPU cycles)
+uint16_t load_cycles = 0;  // last FSK_PP idle PLL load, until on the chip (CPU cycles)
+uint16_t load_max = 0;     // worst FSK_PP idle PLL load (CPU cycles)
+uint16_t tr_cycles = 0;    // last T/R switch time (CPU cycles)
+uint16_t tr_max = 0;       // worst T/R switch time (CPU cycles)
+uint16_t lock_us = 0;      // last PLL lock time (us)
+uint16_t lock_max = 0;     // worst PLL lock time (us)
+uint8_t  lock_fail = 0;    // PLL lock timeouts
+uint16_t bus_wait = 0;     // last tone update wait for the bus (us)
+uint16_t bus_max = 0;      // worst tone update wait for the bus (us)
+uint32_t oled_clock;       // OLED SCL clock after the self-test (Hz)
+uint32_t overlay_t0;       // overlay start (msTimer)
+uint16_t overlay_ms = 0;   // overlay time, 0 if none
+
+// TX telemetry page (TP command)
+uint8_t  telemetry = OFF;  // show the page while transmitting FSK
+uint16_t tone_delta;       // last measured tone period
+uint16_t retunes = 0;      // tone changes sent this second
+uint16_t retune_us = 0;    // worst tone update this second (us)
+uint32_t tm_t0;            // start of this second (msTimer)
+uint32_t tm_bytes;         // si5351.bytes_sent at tm_t0
+uint8_t  tx_page = NO;     // the page is the overlay shown
+
+// CAT parser
+uint8_t  cat_state = CAT_IDLE;
+char     cat_cmd[3] = "zz";     // command letters
+char     cat_param[CAT_PARAMS]; // parameters
+uint8_t  cat_len;
+uint32_t cat_t0;                // last byte of the frame (msTimer)
+uint32_t cat_freq = 0;          // FA frequency held until the end of Tx, 0 if none
+
+// calibration output (CA command), 1 MHz on CLK2
+#define CAL_FREQ  100000000ULL
+uint8_t cal_active = NO;
+uint32_t cal_old;          // cal_data when the cal output came on
+
 // print info to serial port
 void show_info() {
   show_version(SERIAL);
@@ -482,11 +590,115 @@ void show_debug() {
   Serial.println("");
 }
 
+// check the Si5351 register shadow against the chip
+void show_shadow() {
+  uint8_t errs = si5351.check_shadow();
+  Serial.print("  shadow errors = ");
+  Serial.print(errs);
+  if (errs) {
+    Serial.print("  first reg = ");
+    Serial.print(si5351.shadow_err);
+  }
+  Serial.print("\r\n\n");
+}
+
+// print synthesizer statistics
+void show_stats() {
+  Serial.print("  retune bytes = ");
+  Serial.print(si5351.freq_bytes);
+  Serial.print("\r\n  Si5351 bytes = ");
+  Serial.print(si5351.bytes_sent);
+  Serial.print("\r\n  Si5351 xfers = ");
+  Serial.print(si5351.xfers);
+  Serial.print("\r\n  tone hits = ");
+  Serial.print(tone_hits);
+  Serial.print("\r\n  tone miss = ");
+  Serial.print(tone_miss);
+  Serial.print("\r\n  PP tone cycles = ");
+  Serial.print(sw_cycles);
+  Serial.print(" max ");
+  Serial.print(sw_max);
+  Serial.print("\r\n  PLL load cycles = ");
+  Serial.print(load_cycles);
+  Serial.print(" max ");
+  Serial.print(load_max);
+  Serial.print("\r\n  T/R cycles = ");
+  Serial.print(tr_cycles);
+  Serial.print(" max ");
+  Serial.print(tr_max);
+  Serial.print("\r\n  PLL lock us = ");
+  Serial.print(lock_us);
+  Serial.print(" max ");
+  Serial.print(lock_max);
+  Serial.print(" fail ");
+  Serial.print(lock_fail);
+  Serial.print("\r\n  tone bus wait us = ");
+  Serial.print(bus_wait);
+  Serial.print(" max ");
+  Serial.print(bus_max);
+  Serial.print("\r\n  I2C timeouts = ");
+  Serial.print(i2c.timeouts);
+  Serial.print(" recoveries ");
+  Serial.print(i2c.recoveries);
+  Serial.print(" errors ");
+  Serial.print(i2c.errors);
+  Serial.print("\r\n  Si5351 resends = ");
+  Serial.print(si5351.repairs);
+  Serial.print("\r\n  OLED SCL Hz = ");
+  Serial.print(oled_clock);
+  Serial.print("\r\n  OLED cells pending = ");
+  Serial.print(oled.pending());
+  Serial.print(" max ");
+  Serial.print(oled.high_water);
+  Serial.print("\r\n\n");
+}
+
+// select the next FSK synthesis mode
+void show_fsk() {
+  if (++fsk_synth == FSK_MODES) fsk_synth = FSK_MS;
+  Serial.print("FSK=");
+  Serial.println(fsk_label[fsk_synth]);
+}
+
+// compare the 32-bit and 64-bit synthesis math over the tone range
+void show_math() {
+  struct Si5351RegSet r32, r64;
+  uint32_t c32 = 0;
+  uint32_t c64 = 0;
+  uint16_t t0;
+  uint8_t  n = 0;
+  uint8_t  errs = 0;
+  uint16_t div = fsk_divider();
+  for (uint16_t tone=200; tone<=MAXTONE; tone+=100) {
+    uint64_t freq = ((uint64_t)base_freq + tone) * 100;
+    for (uint8_t pll=0; pll<2; pll++) {
+      si5351.fast_math = YES;
+      t0 = cycles();
+      if (pll) si5351.calc_pll(freq * div, SI5351_PLLB, &r32);
+      else si5351.calc_freq(freq, SI5351_CLK1, &r32);
+      c32 += cycles() - t0;
+      si5351.fast_math = NO;
+      t0 = cycles();
+      if (pll) si5351.calc_pll(freq * div, SI5351_PLLB, &r64);
+      else si5351.calc_freq(freq, SI5351_CLK1, &r64);
+      c64 += cycles() - t0;
+      if ((r32.p1 != r64.p1) || (r32.p2 != r64.p2) || (r32.p3 != r64.p3)) errs++;
+      n++;
+    }
+  }
+  si5351.fast_math = SI5351_FAST_MATH;
+  Serial.print("  math errors = ");
+  Serial.print(errs);
+  Serial.print("\r\n  32-bit cycles = ");
+  Serial.print(c32/n);
+  Serial.print("\r\n  64-bit cycles = ");
+  Serial.print(c64/n);
+  Serial.print("\r\n\n");
+}
+
 // print a diagnostic message
 void show_band(char* str) {
-  oled.clrScreen();
-  oled.printline(0, "BAND MODULE");
-  oled.printline(1, str);
+  show_overlay("BAND MODULE", str, THREE_SECONDS);
   Serial.print("BAND MODULE ");
   Serial.println(str);
 }
@@ -495,6 +707,7 @@ void show_band(char* str) {
 void wait_ms(uint16_t dly) {
   uint32_t startTime = msTimer;
   while((msTimer - startTime) < dly) {
+    run_display();
     wait_us(10);
   }
 }
@@ -524,6 +737,38 @@ void error_blink() {
   }
 }
 
+// read the timer1 count (free running at the CPU clock)
+uint16_t cycles() {
+  uint16_t t;
+  uint8_t sreg = SREG;
+  cli();
+  t = TCNT1;
+  SREG = sreg;
+  return t;
+}
+
+// microsecond time from timer 0 (4 us steps)
+uint32_t us_timer() {
+  uint32_t ms;
+  uint8_t t;
+  uint8_t sreg = SREG;
+  cli();
+  ms = msTimer;
+  t = TCNT0;
+  // count a compare match that is not serviced yet
+  if ((TIFR0 & _BV(OCF0A)) && (t < 125)) ms++;
+  SREG = sreg;
+  return (ms * 1000) + (t * 4);
+}
+
+// wait for the PLLs to lock and record how long it took
+void wait_lock(uint8_t mask) {
+  uint32_t t0 = us_timer();
+  if (!si5351.wait_lock(mask)) lock_fail++;
+  lock_us = us_timer() - t0;
+  if (lock_us > lock_max) lock_max = lock_us;
+}
+
 // FSK frequency measurement
 void FSK_tone() {
   doFSK = NO;
@@ -531,24 +776,229 @@ void FSK_tone() {
   vox_timer = msTimer;       // reset the vox timer
   if (delta < MAXCNT) {      // check for valid period
     if (!FSKtx) {
+      init_fsk();
       set_tx_status(TX);
       FSKtx = TRUE;
+      tx_page_start();
     }
-    uint32_t code_freq = CPUXTL/delta;
-    si5351.set_freq(((base_freq*100) + code_freq), SI5351_CLK0);
+    uint32_t t0 = us_timer();
+    set_tone(delta);
+    t0 = us_timer() - t0;
+    if (t0 > retune_us) retune_us = t0;
+    tone_delta = delta;
     vox_timer = msTimer;     // reset the vox timer
   }
 }
 
+// set the Tx tone from the tone cache
+void set_tone(uint16_t delta) {
+  ToneEntry tmp;
+  uint8_t i;
+  // set up again if the VFO, calibration or mode changed
+  if ((tone_base != base_freq) || (tone_cal != cal_data) ||
+      (tone_synth != fsk_synth)) {
+    init_fsk();
+  }
+  // nothing to do if the tone is already on the air
+  if ((fsk_synth == FSK_PP) && (delta == fsk_delta)) return;
+  for (i=0; i<tone_count; i++) {
+    if (tone_cache[i].delta == delta) break;
+  }
+  if (i < tone_count) {
+    tone_hits++;
+    tmp = tone_cache[i];
+  } else {
+    // compute the tone and replace the least recently used
+    tone_miss++;
+    uint64_t tone_freq = ((uint64_t)base_freq*100) + (CPUXTL/delta);
+    tmp.delta = delta;
+    if (fsk_synth != FSK_MS) {
+      si5351.calc_pll(tone_freq * fsk_div, SI5351_PLLB, &tmp.reg);
+    } else {
+      tmp.r_div = si5351.calc_freq(tone_freq, SI5351_CLK0, &tmp.reg);
+    }
+    if (tone_count < TONE_CACHE) tone_count++;
+    i = tone_count - 1;
+  }
+  // move the entry to the front
+  for (; i>0; i--) tone_cache[i] = tone_cache[i-1];
+  tone_cache[0] = tmp;
+  // wait for any display chunk still on the bus,
+  // and resend a tone write that was dropped
+  uint8_t err = 0;
+  uint32_t t0 = us_timer();
+  si5351.flush();
+  bus_wait = us_timer() - t0;
+  if (bus_wait > bus_max) bus_max = bus_wait;
+  uint32_t sent = si5351.bytes_sent;
+  if (fsk_synth == FSK_PLL) {
+    err = si5351.write_pll(SI5351_PLLB, tmp.reg);
+  } else if (fsk_synth == FSK_PP) {
+    // the idle PLL keeps the tone before this one, so a step back
+    // to it is only the switch, else load it while the current tone
+    // stays on the air and let the write reach the chip
+    // the tone is timed from here until the switch is on the chip
+    uint8_t pll = (fsk_pll == SI5351_PLLA) ? SI5351_PLLB : SI5351_PLLA;
+    uint16_t t0 = cycles();
+    if (delta != fsk_idle) {
+      err = si5351.write_pll(pll, tmp.reg);
+      i2c.flush();
+      load_cycles = cycles() - t0;
+      if (load_cycles > load_max) load_max = load_cycles;
+    }
+    // move CLK0 over with a one byte write
+    si5351.set_ms_source(SI5351_CLK0, pll);
+    i2c.flush();
+    sw_cycles = cycles() - t0;
+    if (sw_cycles > sw_max) sw_max = sw_cycles;
+    fsk_pll = pll;
+    fsk_idle = fsk_delta;
+    fsk_delta = delta;
+  } else {
+    err = si5351.set_ms(SI5351_CLK0, tmp.reg, 0, tmp.r_div, 0);
+  }
+  // count only the tones that changed a register
+  if (si5351.bytes_sent != sent) retunes++;
+  // the queue was recovered, send the tone again now
+  if (err) si5351.flush();
+}
+
+// even CLK0 integer divider that keeps every tone inside the VCO
+// range, held to the multisynth range for a bad base_freq
+uint16_t fsk_divider() {
+  uint32_t div = SI5351_PLL_VCO_MAX / (base_freq + MAXTONE);
+  if (div > FSK_DIV_MAX) div = FSK_DIV_MAX;
+  if (div < FSK_DIV_MIN) div = FSK_DIV_MIN;
+  return div & ~1;
+}
+
+// set up CLK0 for the FSK synthesis mode, and start
+// the tone cache for this VFO, calibration and mode
+void init_fsk() {
+  struct Si5351RegSet ms_reg;
+  // the cached tones carry over to the next transmission
+  // until the VFO, calibration or mode changes
+  if ((tone_base != base_freq) || (tone_cal != cal_data) ||
+      (tone_synth != fsk_synth)) {
+    tone_count = 0;
+    tone_base  = base_freq;
+    tone_cal   = cal_data;
+    tone_synth = fsk_synth;
+  }
+  end_fsk();
+  if (fsk_synth != FSK_MS) {
+    fsk_div = fsk_divider();
+    ms_reg.p1 = (128UL * fsk_div) - 512;
+    ms_reg.p2 = 0;
+    ms_reg.p3 = 1;
+    si5351.set_pll((uint64_t)base_freq * 100 * fsk_div, SI5351_PLLB);
+    si5351.set_ms_source(SI5351_CLK0, SI5351_PLLB);
+    si5351.set_ms(SI5351_CLK0, ms_reg, ON, SI5351_OUTPUT_CLK_DIV_1, 0);
+    si5351.pll_reset(SI5351_PLLB);
+    fsk_pll = SI5351_PLLB;
+    fsk_delta = 0;
+    fsk_idle = 0;
+    if (fsk_synth == FSK_PP) {
+      // PLLA is borrowed from Rx until end_fsk()
+      si5351.calc_pll((uint64_t)base_freq * 100 * fsk_div, SI5351_PLLA, &ms_reg);
+      si5351.write_pll(SI5351_PLLA, ms_reg);
+      si5351.pll_reset(SI5351_PLLA);
+      fsk_plla = YES;
+      wait_lock(SI5351_STATUS_LOL_A | SI5351_STATUS_LOL_B);
+    } else {
+      wait_lock(SI5351_STATUS_LOL_B);
+    }
+  } else if (si5351.pll_assignment[SI5351_CLK0] != SI5351_PLLA) {
+    si5351.set_ms_source(SI5351_CLK0, SI5351_PLLA);
+  }
+}
+
+// give PLLA back to Rx after an FSK_PP transmission
+void end_fsk() {
+  if (fsk_plla) {
+    si5351.set_ms_source(SI5351_CLK0, SI5351_PLLB);
+    si5351.set_pll(si5351.plla_freq, SI5351_PLLA);
+    si5351.pll_reset(SI5351_PLLA);
+    wait_lock(SI5351_STATUS_LOL_A);
+    fsk_pll = SI5351_PLLB;
+    fsk_plla = NO;
+  }
+}
+
 // if VOX timeout then return to rx mode
 void check_VOX() {
   if (FSKtx && (msTimer - vox_timer > MAXVOX)) {
     FSKtx = FALSE;
     d2ICR = FALSE;
+    // give PLLA back to Rx before the Rx clock comes on
+    end_fsk();
+    if (cat_freq) {
+      cat_retune(cat_freq);
+      cat_freq = 0;
+    }
     set_tx_status(RX);
+    end_tx_page();
   }
 }
 
+// start the telemetry counts for a transmission
+void tx_page_start() {
+  retunes = 0;
+  retune_us = 0;
+  tm_bytes = si5351.bytes_sent;
+  tm_t0 = msTimer;
+}
+
+// write val right justified in width chars, 9s if it does not fit
+void putnum(char *dst, uint32_t val, uint8_t width) {
+  uint32_t max = 9;
+  for (uint8_t i=1; i<width; i++) max = (max * 10) + 9;
+  if (val > max) val = max;
+  for (uint8_t i=width; i>0; i--) {
+    dst[i-1] = val ? "0123456789"[val % 10] : ' ';
+    val /= 10;
+  }
+  if (dst[width-1] == ' ') dst[width-1] = '0';
+}
+
+// show the TX telemetry page once a second while transmitting FSK,
+// only the digits that change are sent to the OLED
+//   TONE 1523 RT   6   measured tone (Hz), tone changes sent per second
+//   B/S   48 US  412   Si5351 bytes per second, worst tone update (us)
+void show_tx_page() {
+  char line0[17] = "TONE      RT    ";
+  char line1[17] = "B/S      US     ";
+  if (!telemetry || !FSKtx || ((msTimer - tm_t0) < ONE_SECOND)) return;
+  // a timed message stays up, the page comes back after it
+  if (overlay_ms) {
+    tx_page_start();
+    return;
+  }
+  putnum(line0+5, tone_delta ? (CPUXTL/100)/tone_delta : 0, 4);
+  putnum(line0+13, retunes, 3);
+  putnum(line1+4, si5351.bytes_sent - tm_bytes, 4);
+  putnum(line1+12, retune_us, 4);
+  oled.overlay(line0, line1);
+  tx_page = YES;
+  tx_page_start();
+}
+
+// take the TX page off the screen, if it is the overlay shown
+void end_tx_page() {
+  if (tx_page) {
+    oled.restore();
+    tx_page = NO;
+  }
+}
+
+// toggle the TX telemetry page
+void show_telemetry() {
+  telemetry = !telemetry;
+  if (!telemetry) end_tx_page();
+  Serial.print("TP=");
+  Serial.println(telemetry ? "ON" : "OFF");
+}
+
 // print (11-bit) VFO frequency
 inline void CAT_VFO() {
   if      (base_freq >= 10000000) Serial.print("000");
@@ -581,25 +1031,70 @@ inline void CAT_VFO() {
 //  FR => factory reset
 //  SR => soft reset
 //  CM => calibration mode
+//  SV => verify Si5351 regs
+//  SS => synthesizer and bus stats
+//  FS => FSK synthesis mode
+//  MB => synthesis math bench
+//  CA => cal output on (CA;) or calibrate from the measured
+//        cal output frequency in Hz (CA999998.750;)
+//  CE => end calibration and save to EEPROM (CE;), or
+//        put back the old calibration without saving (CE0;)
+//  TP => TX telemetry page on/off
 // ==============================================================
 
 // check for CAT control
+// takes the bytes that have arrived and returns, a command
+// runs when its frame is in, at most one per call
 void check_CAT() {
-  if (Serial.available()) CAT_cmd();
+  char ch;
+  // drop a frame that stopped coming
+  if (cat_state && ((msTimer - cat_t0) > CAT_STALE)) cat_state = CAT_IDLE;
+  while (Serial.available()) {
+    ch = Serial.read();
+    cat_t0 = msTimer;
+    switch (cat_state) {
+      case CAT_IDLE:     // skip to a letter
+        if (alpha(ch)) {
+          cat_cmd[0] = ch;
+          cat_state = CAT_NAME;
+        }
+        break;
+      case CAT_NAME:
+        cat_cmd[1] = ch;
+        uppercase(cat_cmd);
+        cat_param[0] = '\0';
+        cat_len = 0;
+        if (cat_frame(cat_cmd)) {
+          cat_state = CAT_PARAM;
+          break;
+        }
+        cat_state = CAT_IDLE;
+        CAT_cmd();
+        return;
+      case CAT_PARAM:
+        if (ch == ';') {
+          cat_state = CAT_IDLE;
+          CAT_cmd();
+          return;
+        }
+        // keep what fits, the rest of a long frame is dropped
+        if (cat_len < (CAT_PARAMS-1)) {
+          cat_param[cat_len++] = ch;
+          cat_param[cat_len] = '\0';
+        }
+        break;
+      default:
+        cat_state = CAT_IDLE;
+        break;
+    }
+  }
 }
 
+// run the command in cat_cmd with the parameters in cat_param
 void CAT_cmd() {
-  char cmd[3] = "zz";
-  char param[20] = "";
-
-  // get next alpha char from serial buffer
-  char ch = gnac();
-  if (ch == 'z') return;  // non-alpha char
-
-  // get the command
-  cmd[0] = ch;
-  cmd[1] = getc();
-  uppercase(cmd);
+  char *cmd = cat_cmd;
+  char *param = cat_param;
+  char ch = param[0];
 
   // ===========================
   //  TS-2000 CAT commands
@@ -631,17 +1126,13 @@ void CAT_cmd() {
 
   // get or set frequency
   else if (cmpstr(cmd, "FA")) {
-    ch = getc();
     if (numeric(ch)) {
-      // set frequency
-      catstr(param, ch);
-      for (uint8_t i=0; i<10; i++) {
-        catstr(param, getc());
-      }
-      base_freq = fs2int(param);
-      // set band and mode
-      freq2band(base_freq);
-      getsemi(); // get semicolon
+      // set frequency, 11 digits
+      // a short frame is ignored
+      if (cat_len < 11) return;
+      // a tone is on the air, retune at the end of the transmission
+      if (FSKtx) cat_freq = fs2int(param);
+      else cat_retune(fs2int(param));
     } else {
       // get frequency
       Serial.print("FA");
@@ -652,11 +1143,9 @@ void CAT_cmd() {
 
   // get or set the radio mode
   else if (cmpstr(cmd, "MD")) {
-    ch = getc();
     if (numeric(ch)) {
       // set radio mode
       // does nothing .. always 2
-      getsemi();
     } else {
       // get auto-information status
       Serial.print("MD2;");
@@ -665,11 +1154,9 @@ void CAT_cmd() {
 
   // get or set auto-information status
   else if (cmpstr(cmd, "AI")) {
-    ch = getc();
     if (numeric(ch)) {
       // set auto-information status
       // does nothing .. always 0
-      getsemi();
     } else {
       // get auto-information status
       Serial.print("AI0;");
@@ -678,11 +1165,9 @@ void CAT_cmd() {
 
   // get or set the power (ON/OFF) status
   else if (cmpstr(cmd, "PS")) {
-    ch = getc();
     if (numeric(ch)) {
       // set power (ON/OFF) status
       // does nothing .. always 1
-      getsemi();
     } else {
       // get power (ON/OFF) status
       Serial.print("PS1;");
@@ -691,11 +1176,9 @@ void CAT_cmd() {
 
   // get or set the XIT (ON/OFF) status
   else if (cmpstr(cmd, "XT")) {
-    ch = getc();
     if (numeric(ch)) {
       // set XIT (ON/OFF) status
       // does nothing .. always OFF
-      getsemi();
     } else {
       // get XIT (ON/OFF) status
       Serial.print("XT0;");
@@ -704,13 +1187,11 @@ void CAT_cmd() {
 
   // CAT transmit
   else if (cmpstr(cmd, "TX")) {
-    getsemi(); // get semicolon
     tx_status = TX;
   }
 
   // CAT receive
   else if (cmpstr(cmd, "RX")) {
-    getsemi(); // get semicolon
     tx_status = RX;
   }
 
@@ -753,6 +1234,41 @@ void CAT_cmd() {
     run_calibrate();
   }
 
+  // verify Si5351 register shadow
+  else if (cmpstr(cmd, "SV")) {
+    show_shadow();
+  }
+
+  // print synthesizer statistics
+  else if (cmpstr(cmd, "SS")) {
+    show_stats();
+  }
+
+  // select the FSK synthesis mode
+  else if (cmpstr(cmd, "FS")) {
+    show_fsk();
+  }
+
+  // compare the 32-bit and 64-bit synthesis math
+  else if (cmpstr(cmd, "MB")) {
+    show_math();
+  }
+
+  // calibrate from a measured frequency
+  else if (cmpstr(cmd, "CA")) {
+    cal_cmd(param);
+  }
+
+  // end calibration and save
+  else if (cmpstr(cmd, "CE")) {
+    cal_end(param);
+  }
+
+  // toggle the TX telemetry page
+  else if (cmpstr(cmd, "TP")) {
+    show_telemetry();
+  }
+
 }
 
 // write config data to the eeprom
@@ -764,20 +1280,61 @@ void save_eeprom() {
 
 // initialize the Si5351 VFO clocks
 void init_VFO() {
+  // the init image has the clock drive strengths
+  // and all clocks off (Cal off)
   si5351.init();
-  si5351.set_pll(SI5351_PLL_FIXED, SI5351_PLLA);
+  wait_lock(SI5351_STATUS_LOL_A | SI5351_STATUS_LOL_B);
   set_tx_status(RX);
-  si5351.output_enable(SI5351_CLK2, OFF);   // Cal off
-  // clock drive strength
-  si5351.drive_strength(SI5351_CLK0, SI5351_DRIVE_8MA);
-  si5351.drive_strength(SI5351_CLK1, SI5351_DRIVE_2MA);
-  si5351.drive_strength(SI5351_CLK2, SI5351_DRIVE_2MA);
 }
 
 // initialize the Si5351 frequency
 void init_freq() {
   si5351.set_correction(cal_data, SI5351_PLL_INPUT_XO);
-  si5351.set_freq(base_freq*100, SI5351_CLK1);
+  wait_lock(SI5351_STATUS_LOL_A);
+  set_rx_freq(base_freq);
+}
+
+// set the Rx clock frequency
+// the freq2band() frequencies load a preset from presets.h
+// others use the fixed PLL and a fractional multisynth
+void set_rx_freq(uint32_t freq) {
+  struct Si5351Preset p;
+  uint64_t pll_freq = SI5351_PLL_FIXED;
+  uint8_t  i;
+  uint8_t  err = 0;
+  for (i = 0; i < PRESETS; i++) {
+    if (pgm_read_dword(&presets[i].freq) == freq) break;
+  }
+  if (i < PRESETS) {
+    memcpy_P(&p, &presets[i], sizeof(p));
+    pll_freq = (uint64_t)p.pll * 100;
+  }
+  // the PLL is reset only when it changes
+  if (si5351.plla_freq != pll_freq) {
+    err = si5351.set_pll(pll_freq, SI5351_PLLA);
+    si5351.pll_reset(SI5351_PLLA);
+    wait_lock(SI5351_STATUS_LOL_A);
+    // the cal output runs from PLLA too
+    if (cal_active && si5351.set_freq(CAL_FREQ, SI5351_CLK2)) err = YES;
+  }
+  if (i < PRESETS) {
+    if (si5351.set_ms(SI5351_CLK1, p.ms, p.int_mode, p.r_div, 0)) err = YES;
+  } else {
+    if (si5351.set_freq((uint64_t)freq*100, SI5351_CLK1)) err = YES;
+  }
+  // a failed or dropped write is resent from the shadow,
+  // wait once more for the resend
+  if (err || si5351.flush()) si5351.flush();
+}
+
+// set the frequency from CAT
+// retune Rx first, the display is redrawn later
+void cat_retune(uint32_t freq) {
+  base_freq = freq;
+  set_rx_freq(base_freq);
+  // set band and mode
+  freq2band(base_freq);
+  redraw = YES;
 }
 
 // initialize timer 0
@@ -813,8 +1370,13 @@ void init_pins() {
 }
 
 // initialize the I2C bus
+#if (OLED_CLOCK > I2C_MAX_CLOCK) || (SI5351_I2C_CLOCK > I2C_MAX_CLOCK)
+#error "I2C clock is over I2C_MAX_CLOCK for this board"
+#endif
+
 void init_i2c() {
   i2c.begin();
+  i2c.setClock(SI5351_I2C_ADDR, SI5351_I2C_CLOCK);
 }
 
 // initialize the serial port
@@ -823,13 +1385,44 @@ void init_uart() {
   Serial.begin(BAUDRATE);
 }
 
-// initialize the OLED
+// initialize the OLED, at OLED_CLOCK if it answers at that rate
 void init_oled() {
+  oled_clock = OLED_CLOCK;
+  i2c.setClock(OLED_ADDR, oled_clock);
+  if (i2c.probe(OLED_ADDR)) {
+    oled_clock = I2C_CLOCK;
+    i2c.setClock(OLED_ADDR, oled_clock);
+  }
   oled.begin();
   display = ON;
   oled.onDisplay();
 }
 
+// send the next page of display updates, held while
+// transmitting FSK so the bus is free for the tones,
+// unless the TX telemetry page is on
+void run_display() {
+  if (overlay_ms && ((msTimer - overlay_t0) >= overlay_ms)) {
+    overlay_ms = 0;
+    oled.restore();
+  }
+  if (!FSKtx || telemetry) oled.update();
+}
+
+// show a message over the screen for a time (ms),
+// the screen under it is still updated and comes back after
+void show_overlay(char *line0, char *line1, uint16_t ms) {
+  oled.overlay(line0, line1);
+  tx_page = NO;
+  overlay_t0 = msTimer;
+  overlay_ms = ms;
+}
+
+// run the FSK measurement while the OLED waits for the bus
+void oled_idle() {
+  if (doFSK) FSK_tone();
+}
+
 // check for factory reset during setup
 void init_check() {
   if (UIKEY) do_reset(FACTORY);
@@ -850,19 +1443,33 @@ void read_adc() {
 }
 
 // set the Rx/Tx status
+// the Rx gate is always closed while the Tx clock is on,
+// and one register write swaps the Rx and Tx clocks
 void set_tx_status(uint8_t x) {
+  uint16_t t0 = cycles();
   if (x == TX) {
     tx_status = TX;
-    digitalWrite(TXLED,  ON);
-    digitalWrite(RXGATE, OFF);
-    si5351.output_enable(SI5351_CLK1, OFF);  // Rx off
-    si5351.output_enable(SI5351_CLK0, ON);   // Tx on
+    RXGATE_OFF;
+    if (TX_GUARD) wait_us(TX_GUARD);
+    switch_clocks(SI5351_CLK1, SI5351_CLK0);  // Rx off, Tx on
+    TXLED_ON;
   } else {
     tx_status = RX;
-    si5351.output_enable(SI5351_CLK0, OFF);  // Tx off
-    si5351.output_enable(SI5351_CLK1, ON);   // Rx on
-    digitalWrite(TXLED,  OFF);
-    digitalWrite(RXGATE, ON);
+    switch_clocks(SI5351_CLK0, SI5351_CLK1);  // Tx off, Rx on
+    if (RX_GUARD) wait_us(RX_GUARD);
+    RXGATE_ON;
+    TXLED_OFF;
+  }
+  tr_cycles = cycles() - t0;
+  if (tr_cycles > tr_max) tr_max = tr_cycles;
+}
+
+// swap the Rx and Tx clocks and wait for the write,
+// send it again if it failed or was dropped on the bus
+void switch_clocks(uint8_t off_clk, uint8_t on_clk) {
+  if (si5351.output_switch(off_clk, on_clk) || si5351.flush()) {
+    si5351.output_switch(off_clk, on_clk);
+    si5351.flush();
   }
 }
 
@@ -904,6 +1511,7 @@ void tuning_mode() {
     }
     reset_xtimer();
     check_CAT();          // check CAT interface
+    run_display();        // display task
   }
 }
 
@@ -911,6 +1519,7 @@ void tuning_mode() {
 void manualTX() {
   set_tx_status(TX);
   oled.printline(1,"XMIT");
+  si5351.set_ms_source(SI5351_CLK0, SI5351_PLLA);
   si5351.set_freq(base_freq*100, SI5351_CLK0);
   reset_xtimer();
   while (UIKEY) {
@@ -990,9 +1599,15 @@ uint8_t check_band() {
       if (bandID == band) {
         return TRUE;
       } else {
-        show_band(band_label[bandID]);
-        oled.putstr(" != ");
-        oled.putstr(band_label[band]);
+        // one message with the module band and the VFO band
+        char msg[16] = "";
+        const char *s;
+        for (s=band_label[bandID]; *s; s++) catstr(msg, *s);
+        for (s=" != "; *s; s++) catstr(msg, *s);
+        for (s=band_label[band]; *s; s++) catstr(msg, *s);
+        show_overlay("BAND MODULE", msg, THREE_SECONDS);
+        Serial.print("BAND MODULE ");
+        Serial.println(band_label[bandID]);
         Serial.print("BAND = ");
         Serial.println(band_label[band]);
       }
@@ -1006,8 +1621,6 @@ uint8_t check_band() {
     default:
       break;
   }
-  wait_ms(THREE_SECONDS);
-  oled.clrScreen();
   return FALSE;
 }
 
@@ -1262,10 +1875,17 @@ void update_freq(uint32_t freq) {
     // requested frequency is not OK
     error_blink();
   }
-  si5351.set_freq(freq*100, SI5351_CLK1);
+  set_rx_freq(freq);
   base_freq = freq;
+  // keep the bus free for the tones while transmitting
+  if (FSKtx) redraw = YES;
+  else draw_freq();
+}
+
+// draw the mode/band/freq display
+void draw_freq() {
+  redraw = NO;
   getmode();
-  oled.clrScreen();
   oled.printline(0, modestr);
   oled.print32(base_freq);
 }
@@ -1340,10 +1960,9 @@ void refresh() {
 
 // reset (CAT command)
 void do_reset(uint8_t soft) {
-  oled.clrScreen();
   if (soft) {
     // soft reset
-    oled.putstr("SOFT RESET");
+    show_overlay("SOFT RESET", "", TWO_SECONDS);
     init_uart();
     Serial.print("  Soft Reset\r\n");
     Serial.print("  Reading EEPROM\r\n");
@@ -1351,7 +1970,7 @@ void do_reset(uint8_t soft) {
     update_freq(eeprom.get32(FREQ_ADDR));
   } else {
     // factory reset
-    oled.putstr("FACTORY RESET");
+    show_overlay("FACTORY RESET", "", TWO_SECONDS);
     init_uart();
     Serial.print("  Factory Reset\r\n");
     cal_data = CAL_DATA_INIT;
@@ -1360,12 +1979,9 @@ void do_reset(uint8_t soft) {
   }
   show_cal();
   set_tx_status(RX);
-  wait_ms(TWO_SECONDS);
   refresh();
 }
 
-#define CAL_FREQ  100000000ULL
-
 #define CAL_MSG  "\r\n\
   Adjust cal freq to 1 MHz\r\n\
   press + to increase cal freq\r\n\
@@ -1374,6 +1990,74 @@ void do_reset(uint8_t soft) {
   press . to save and exit\r\n\
   press / to exit without saving\r\n\n"
 
+// closed-form calibration (CAT command)
+// CA;             turns on the cal output on CLK2
+// CA<Hz>;         sets cal_data from the measured cal output
+// the radio keeps running while the cal output is on
+void cal_cmd(char *param) {
+  uint32_t meas = 0;    // measured frequency (mHz)
+  uint8_t  dp = 0;      // 1 + digits after the decimal point
+  uint8_t  digits = 0;
+  int64_t  cal;
+  char ch;
+  while ((ch = *param++)) {
+    if (numeric(ch) && (dp < 4)) {
+      meas = (meas * 10) + (ch - '0');
+      digits++;
+      if (dp) dp++;
+    } else if (ch == '.') {
+      if (!dp) dp = 1;
+    }
+  }
+  // set CLK2 every time, it follows PLLA
+  si5351.set_freq(CAL_FREQ, SI5351_CLK2);
+  if (!cal_active) {
+    si5351.set_clock_pwr(SI5351_CLK2, ON);
+    si5351.output_enable(SI5351_CLK2, ON);
+    cal_old = cal_data;
+    cal_active = YES;
+    Serial.print("  Cal output on\r\n");
+  }
+  if (!digits) return;
+  if (!dp) dp = 1;
+  for (; dp < 4; dp++) meas *= 10;
+  // the output scales with the reference error, so
+  // (1e9 + new) = (1e9 + old) * measured / nominal (ppb)
+  cal = (1000000000LL + (int32_t)cal_data) * meas;
+  cal = ((cal + (CAL_FREQ * 5)) / (CAL_FREQ * 10)) - 1000000000LL;
+  // more than 1000 ppm off is not a 1 MHz measurement
+  if ((cal > 1000000L) || (cal < -1000000L)) {
+    Serial.print("  Cal freq out of range\r\n");
+    return;
+  }
+  cal_data = (int32_t)cal;
+  si5351.set_correction(cal_data, SI5351_PLL_INPUT_XO);
+  wait_lock(SI5351_STATUS_LOL_A);
+  show_cal();
+}
+
+// end calibration (CAT command)
+// CE;             saves cal_data to EEPROM
+// CE0;            puts back cal_data from before CA, not saved
+void cal_end(char *param) {
+  uint8_t save = (param[0] != '0');
+  if (cal_active) {
+    si5351.output_enable(SI5351_CLK2, OFF);
+    si5351.set_clock_pwr(SI5351_CLK2, OFF);
+    cal_active = NO;
+    if (!save && (cal_data != cal_old)) {
+      cal_data = cal_old;
+      si5351.set_correction(cal_data, SI5351_PLL_INPUT_XO);
+      wait_lock(SI5351_STATUS_LOL_A);
+    }
+  }
+  show_cal();
+  if (save) {
+    Serial.print("  Saving to EEPROM\r\n");
+    eeprom.put32(DATA_ADDR, cal_data);
+  }
+}
+
 // calibrate the VFO (CAT command)
 void run_calibrate() {
   char ch;
@@ -1384,7 +2068,7 @@ void run_calibrate() {
   uint8_t save = YES;
   reset_xtimer();
   // print to serial port
-  Serial.print(CAL_MSG);
+  Serial.print(F(CAL_MSG));
   // print to OLED
   oled.clrScreen();
   oled.putstr("CALIBRATION MODE");
@@ -1423,7 +2107,7 @@ void run_calibrate() {
       if (up) cal_data = cal_data - 10;
       if (dn) cal_data = cal_data + 10;
       si5351.set_correction(cal_data, SI5351_PLL_INPUT_XO);
-      wait_us(100);
+      wait_lock(SI5351_STATUS_LOL_A);
       si5351.set_freq(CAL_FREQ, SI5351_CLK2);
       if (xx == 0) Serial.print(ch);
       if (xx++ == 100) xx = 0;
@@ -1436,12 +2120,11 @@ void run_calibrate() {
   Serial.print("\r\n\  Exiting Calibration Mode\r\n");
   show_cal();
   // print to OLED
-  oled.printline(0,"CAL COMPLETE");
+  show_overlay("CAL COMPLETE", "", TWO_SECONDS);
   if (save) {
     Serial.print("  Saving to EEPROM\r\n");
     eeprom.put32(DATA_ADDR, cal_data);
   }
-  wait_ms(TWO_SECONDS);
   refresh();
 }
 
@@ -1459,6 +2142,7 @@ int main() {
   init_check();
   init_freq();
   refresh();
+  oled.idle = oled_idle;        // FSK runs during display updates
   loopCount=0;
   // main loop
   while (TRUE) {
@@ -1466,6 +2150,9 @@ int main() {
     check_UI();                 // check UI pushbutton
     if (doFSK) FSK_tone();      // measure FSK frequency
     if (FSKtx) check_VOX();     // check for VOX timeout
+    if (FSKtx) show_tx_page();  // TX telemetry page
+    else if (redraw) draw_freq(); // deferred display update
+    run_display();              // display task
     if (loopCount > TWO_SECONDS) {
       // LED heartbeat
       if (tx_status != TX) blinkLED();
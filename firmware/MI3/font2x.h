@@ -0,0 +1,543 @@
+// ============================================================================
+//
+// font2x.h - font.h stretched to double height for the OLED driver
+//
+// generated by firmware/tools/fontgen.cpp, do not edit
+//
+// ============================================================================
+
+#ifndef FONT2X_H
+#define FONT2X_H
+
+#define FONT2X_BYTES  32   // bytes per glyph, 4 pages of 8
+#define FONT2X_GLYPHS 105  // from char 32
+
+const uint8_t font2x[] PROGMEM = {
+  // SPACE
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // !
+  0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00,
+  // "
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // #
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x0f, 0xff, 0xff, 0x0f, 0x0f, 0xff, 0xff, 0x0f,
+  0x0f, 0xff, 0xff, 0x0f, 0x0f, 0xff, 0xff, 0x0f,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  // $
+  0x00, 0x00, 0xf0, 0xff, 0xff, 0xf0, 0xf0, 0x00,
+  0x00, 0x0f, 0xff, 0xf0, 0xf0, 0xf0, 0x00, 0x00,
+  0x00, 0xf0, 0xf0, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  // %
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xf0, 0xff, 0x00,
+  0x00, 0x00, 0x00, 0xf0, 0xff, 0x0f, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x00, 0xf0, 0xf0, 0x00,
+  0x00, 0x0f, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  // &
+  0x00, 0x00, 0xf0, 0xff, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x00, 0xff, 0xff, 0xf0, 0x0f, 0xf0, 0xf0,
+  0x00, 0xff, 0xff, 0x00, 0x0f, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x00, 0x0f, 0x0f,
+  // '
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // (
+  0x00, 0x00, 0x00, 0xf0, 0x0f, 0x0f, 0x00, 0x00,
+  0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0xff, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00,
+  // )
+  0x00, 0x00, 0x0f, 0x0f, 0xf0, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xff, 0x0f, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00,
+  // *
+  0x00, 0xf0, 0xf0, 0x00, 0x00, 0xf0, 0xf0, 0x00,
+  0xf0, 0xf0, 0xff, 0xff, 0xff, 0xff, 0xf0, 0xf0,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // +
+  0x00, 0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xf0, 0xff, 0xff, 0xf0, 0xf0, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // ,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0xff, 0x00, 0x00, 0x00,
+  // -
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // .
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00,
+  // /
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0xf0, 0xff, 0x0f, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // 0
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // 1
+  0x00, 0x00, 0xf0, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  // 2
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x00, 0xf0, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  // 3
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x00, 0x00, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0xf0, 0xf0, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // 4
+  0x00, 0x00, 0x00, 0xf0, 0xff, 0xff, 0xff, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0xff, 0xff, 0x0f,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  // 5
+  0x00, 0xff, 0xff, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xf0, 0xf0, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // 6
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0xf0, 0xf0, 0xf0, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // 7
+  0x00, 0xff, 0x0f, 0x0f, 0x0f, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00,
+  // 8
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x0f, 0xff, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // 9
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x0f, 0xff, 0xf0, 0xf0, 0xff, 0xff, 0x00,
+  0x00, 0xf0, 0xf0, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // :
+  0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // ;
+  0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x00, 0x00,
+  // <
+  0x00, 0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0xff, 0xf0, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // =
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // >
+  0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0xff, 0xf0, 0x00, 0x00,
+  0x00, 0x00, 0xf0, 0xff, 0x0f, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // ?
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  // @
+  0x00, 0xf0, 0x0f, 0x0f, 0x0f, 0xf0, 0x00, 0x00,
+  0x00, 0xff, 0x00, 0xff, 0x0f, 0xff, 0x00, 0x00,
+  0x00, 0xff, 0x00, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // A
+  0x00, 0x00, 0xf0, 0xff, 0xff, 0xf0, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0xf0, 0xf0, 0xff, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  // B
+  0x00, 0xff, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // C
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xf0, 0xf0, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // D
+  0x00, 0xff, 0xff, 0x0f, 0xff, 0xf0, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  // E
+  0x00, 0xff, 0xff, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  0x00, 0xff, 0xff, 0xf0, 0xf0, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  // F
+  0x00, 0xff, 0xff, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  0x00, 0xff, 0xff, 0xf0, 0xf0, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // G
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0xf0, 0xf0, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // H
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0xf0, 0xf0, 0xff, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  // I
+  0x00, 0x00, 0x0f, 0xff, 0xff, 0x0f, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // J
+  0x00, 0x00, 0x00, 0x0f, 0xff, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00,
+  0x00, 0xf0, 0xf0, 0x00, 0xff, 0xff, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  // K
+  0x00, 0xff, 0xff, 0x00, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0xff, 0xff, 0xff, 0x0f, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x0f, 0xff, 0xf0, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  // L
+  0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  // M
+  0x00, 0xff, 0xff, 0xf0, 0x00, 0xf0, 0xff, 0xff,
+  0x00, 0xff, 0xff, 0x0f, 0xff, 0x0f, 0xff, 0xff,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0xff, 0xff,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x0f, 0x0f,
+  // N
+  0x00, 0xff, 0xff, 0xf0, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x0f, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  // O
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // P
+  0x00, 0xff, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // Q
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0xff, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x00,
+  // R
+  0x00, 0xff, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0xff, 0xff, 0x0f, 0xff, 0xf0, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  // S
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x0f, 0xff, 0xf0, 0xf0, 0xf0, 0x00, 0x00,
+  0x00, 0xf0, 0xf0, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // T
+  0x00, 0x0f, 0x0f, 0xff, 0xff, 0x0f, 0x0f, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  // U
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // V
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0xff, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  // W
+  0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0xff, 0xff,
+  0x00, 0xff, 0xff, 0x00, 0xf0, 0x00, 0xff, 0xff,
+  0x00, 0xff, 0xff, 0xff, 0x0f, 0xff, 0xff, 0xff,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x0f, 0x0f,
+  // X
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0xff, 0xff, 0x0f, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  // Y
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0xff, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  // Z
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x00, 0xf0, 0xff, 0x0f, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  // [
+  0x00, 0x00, 0xff, 0xff, 0x0f, 0x0f, 0x00, 0x00,
+  0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // '\'
+  0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0xff, 0xf0, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // ]
+  0x00, 0x00, 0x0f, 0x0f, 0xff, 0xff, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // ^
+  0x00, 0x00, 0x00, 0xf0, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0x0f, 0x00, 0x0f, 0xf0, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // _
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  // '
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // a
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  // b
+  0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0xf0, 0xf0, 0xf0, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // c
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // d
+  0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0x00,
+  0x00, 0x00, 0xf0, 0xf0, 0xf0, 0xff, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  // e
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // f
+  0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0xf0, 0x00,
+  0x00, 0x00, 0xf0, 0xff, 0xff, 0xf0, 0xf0, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  // g
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0xff, 0xf0, 0xf0, 0xff, 0xff, 0x00,
+  0x00, 0xf0, 0xf0, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  // h
+  0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0xf0, 0xf0, 0xf0, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  // i
+  0x00, 0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  // j
+  0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00,
+  0x00, 0x00, 0xff, 0xf0, 0xff, 0x0f, 0x00, 0x00,
+  // k
+  0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0xff, 0xff, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x0f, 0xff, 0xf0, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  // l
+  0x00, 0x00, 0xf0, 0xf0, 0xf0, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // m
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x0f, 0xff, 0x0f, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x0f, 0x00, 0x0f, 0x00,
+  // n
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  // o
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // p
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // q
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0xff, 0xf0, 0xf0, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x00,
+  // r
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // s
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // t
+  0x00, 0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0xff, 0xff, 0x0f, 0x0f, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x00,
+  // u
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  // v
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0xff, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  // w
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // x
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0xff, 0xf0, 0xf0, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0xf0, 0xff, 0xff, 0xf0, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x00, 0x00, 0x0f, 0x0f, 0x00,
+  // y
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x0f, 0xff, 0xf0, 0xf0, 0xff, 0xff, 0x00,
+  0x00, 0xf0, 0xf0, 0xf0, 0xff, 0xff, 0x0f, 0x00,
+  // z
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0xff, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0xf0, 0xff, 0x0f, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  // {
+  0x00, 0x00, 0xf0, 0xff, 0x0f, 0x0f, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // |
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  // }
+  0x00, 0x00, 0x0f, 0x0f, 0xff, 0xf0, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  // ~
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00, 0xf0, 0x00,
+  0x00, 0x0f, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // 0
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xff, 0xff, 0x00, 0x00, 0xff, 0xff, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // 1
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xf0, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // 2
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0x0f, 0x0f, 0xff, 0xff, 0x00, 0x00,
+  0x00, 0x00, 0xf0, 0xff, 0x0f, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x00,
+  // 3
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xf0, 0xf0, 0x00, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // 4
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xf0, 0x00, 0xff, 0xff, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0xff, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00,
+  // 5
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0xff, 0xf0, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  // 6
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0x00, 0x00, 0x00,
+  0x00, 0xff, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // 7
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x0f, 0x0f, 0x0f, 0xff, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0xf0, 0xff, 0x0f, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x00, 0x00, 0x00, 0x00,
+  // 8
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x0f, 0x00, 0x00,
+  // 9
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xf0, 0xff, 0x0f, 0x0f, 0xff, 0xf0, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0xff, 0xff, 0x0f, 0x00,
+  0x00, 0x00, 0x0f, 0x0f, 0x0f, 0x00, 0x00, 0x00
+};
+
+#endif
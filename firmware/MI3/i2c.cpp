@@ -9,9 +9,70 @@
 #include <inttypes.h>
 #include "i2c.h"
 
+// transaction queue, served by the TWI interrupt
+struct I2CXfer {
+  uint8_t address;
+  uint8_t reg;
+  uint8_t len;
+  uint8_t flags;
+};
+
+static I2CXfer queue[I2C_QUEUE];
+static uint8_t buf[I2C_BUFFER];
+static volatile uint8_t q_head = 0;     // next free slot
+static volatile uint8_t q_tail = 0;     // transaction on the bus
+static volatile uint8_t q_count = 0;
+static volatile uint8_t b_head = 0;     // next free data byte
+static volatile uint8_t b_tail = 0;     // next data byte to send
+static volatile uint8_t b_count = 0;
+static volatile uint8_t left;           // data bytes left in the tail
+static volatile uint8_t busy = 0;
+static volatile uint8_t steps = 0;      // interrupts, to see progress
+
+// SCL clock for each device, set before each transaction,
+// and the registers of its writes that were dropped
+struct I2CClock {
+  uint8_t address;      // 0 if unused
+  uint8_t twbr;
+  uint8_t twps;
+  uint8_t lost_first;   // first dropped register
+  uint8_t lost_last;    // after the last one, 0 if none
+};
+
+static I2CClock clocks[I2C_DEVICES];
+
+volatile uint16_t I2C::timeouts = 0;
+volatile uint16_t I2C::recoveries = 0;
+volatile uint16_t I2C::errors = 0;
+
 I2C::I2C() {
 }
 
+// set the SCL clock for the next transaction
+static void rate(uint8_t address) {
+  uint8_t twbr = ((F_CPU / I2C_CLOCK) - 16) / 2;
+  uint8_t twps = 0;
+  for (uint8_t i = 0; i < I2C_DEVICES; i++) {
+    if (clocks[i].address == address) {
+      twbr = clocks[i].twbr;
+      twps = clocks[i].twps;
+    }
+  }
+  TWBR = twbr;
+  TWSR = twps;
+}
+
+// note the registers of a write that was dropped
+static void lose(uint8_t address, uint8_t reg, uint8_t len) {
+  uint8_t last = ((reg + len) > 255) ? 255 : (reg + len);
+  for (uint8_t i = 0; i < I2C_DEVICES; i++) {
+    if (clocks[i].address == address) {
+      if (!clocks[i].lost_last || (reg < clocks[i].lost_first)) clocks[i].lost_first = reg;
+      if (last > clocks[i].lost_last) clocks[i].lost_last = last;
+    }
+  }
+}
+
 // Public Methods
 
 void I2C::begin() {
@@ -19,7 +80,7 @@ void I2C::begin() {
   sbi(PORTC, 5);
   cbi(TWSR, TWPS0);
   cbi(TWSR, TWPS1);
-  TWBR = ((F_CPU / 400000) - 16) / 2;
+  TWBR = ((F_CPU / I2C_CLOCK) - 16) / 2;
   TWCR = _BV(TWEN) | _BV(TWEA);
 }
 
@@ -27,111 +88,363 @@ void I2C::end() {
   TWCR = 0;
 }
 
-void I2C::write(uint8_t address, uint8_t registerAddress, uint8_t data) {
-  start();
-  sendAddress(SLA_W(address));
-  sendByte(registerAddress);
-  sendByte(data);
-  stop();
+// set the SCL clock for a device, limited to I2C_MAX_CLOCK
+// SCL = F_CPU / (16 + 2 * TWBR * 4^TWPS), rounded down
+void I2C::setClock(uint8_t address, uint32_t hz) {
+  uint8_t i;
+  uint8_t ps = 0;
+  uint32_t div;
+  if (hz > I2C_MAX_CLOCK) hz = I2C_MAX_CLOCK;
+  if (hz > F_CPU / 16) hz = F_CPU / 16;
+  div = ((F_CPU + hz - 1) / hz - 16 + 1) / 2;
+  while ((div > 255) && (ps < 3)) {
+    div = (div + 3) / 4;
+    ps++;
+  }
+  if (div > 255) div = 255;
+  // replace the device entry, or use a free one
+  for (i = 0; i < I2C_DEVICES - 1; i++) {
+    if ((clocks[i].address == address) || (clocks[i].address == 0)) break;
+  }
+  clocks[i].address = address;
+  clocks[i].twbr = div;
+  clocks[i].twps = ps;
+}
+
+// check that a device answers its address, returns the I2C error code
+uint8_t I2C::probe(uint8_t address) {
+  uint8_t err = flush();
+  rate(address);
+  if (!err) err = start();
+  if (!err) err = sendAddress(SLA_W(address));
+  if (!err) err = stop();
+  return(err);
+}
+
+// the writes are queued and return at once,
+// the error is for a queue that had to be recovered
+
+uint8_t I2C::write(uint8_t address, uint8_t registerAddress, uint8_t data) {
+  return(put(address, registerAddress, &data, 1, 0));
+}
+
+uint8_t I2C::write(uint8_t address, uint8_t registerAddress, uint8_t *data, uint8_t numberBytes) {
+  return(put(address, registerAddress, data, numberBytes, 0));
 }
 
-void I2C::write(uint8_t address, uint8_t registerAddress, uint8_t *data, uint8_t numberBytes) {
-  start();
-  sendAddress(SLA_W(address));
-  sendByte(registerAddress);
-  for (uint8_t i = 0; i < numberBytes; i++) sendByte(data[i]);
-  stop();
+uint8_t I2C::write_P(uint8_t address, uint8_t registerAddress, const uint8_t *data, uint8_t numberBytes) {
+  return(put(address, registerAddress, data, numberBytes, I2C_PGM));
 }
 
-void I2C::writezeros(uint8_t address, uint8_t registerAddress, uint8_t numberBytes) {
-  start();
-  sendAddress(SLA_W(address));
-  sendByte(registerAddress);
-  for (uint8_t i = 0; i < numberBytes; i++) sendByte(0);
-  stop();
+uint8_t I2C::writezeros(uint8_t address, uint8_t registerAddress, uint8_t numberBytes) {
+  return(put(address, registerAddress, 0, numberBytes, I2C_ZEROS));
+}
+
+// wait until the queued writes are done
+uint8_t I2C::flush() {
+  if (waitQueue(0, 0)) return(I2C_TIMEOUT_ERR);
+  return(waitStop());
+}
+
+// check for queued writes
+uint8_t I2C::pending() {
+  return(busy);
+}
+
+// get and clear the register range of the writes to a device that
+// were dropped by a NACK or a bus recovery, returns 0 if none
+uint8_t I2C::dropped(uint8_t address, uint8_t *first, uint8_t *last) {
+  uint8_t sreg = SREG;
+  *first = 0;
+  *last = 0;
+  cli();
+  for (uint8_t i = 0; i < I2C_DEVICES; i++) {
+    if ((clocks[i].address == address) && clocks[i].lost_last) {
+      *first = clocks[i].lost_first;
+      *last = clocks[i].lost_last;
+      clocks[i].lost_last = 0;
+    }
+  }
+  SREG = sreg;
+  return(*last != 0);
 }
 
+// the reads wait for the queue and then run polled,
+// the data reads as 0xFF after an error
+
 uint8_t I2C::read(uint8_t address, uint8_t registerAddress) {
-  start();
-  sendAddress(SLA_W(address));
-  sendByte(registerAddress);
-  start();
-  sendAddress(SLA_R(address));
-  receiveByte();
-  stop();
-  return(TWDR);
+  uint8_t data;
+  read(address, registerAddress, &data, 1);
+  return(data);
+}
+
+uint8_t I2C::read(uint8_t address, uint8_t registerAddress, uint8_t *data, uint8_t numberBytes) {
+  uint8_t err = flush();
+  rate(address);
+  if (!err) err = start();
+  if (!err) err = sendAddress(SLA_W(address));
+  if (!err) err = sendByte(registerAddress);
+  if (!err) err = start();
+  if (!err) err = sendAddress(SLA_R(address));
+  for (uint8_t i = 0; i < numberBytes; i++) {
+    data[i] = 0xFF;
+    // ACK every byte but the last
+    if (!err) err = receiveByte(i < (numberBytes - 1));
+    if (!err) data[i] = TWDR;
+  }
+  if (!err) err = stop();
+  return(err);
 }
 
 // Private Methods
 
+// queue a write, waiting for room if the queue is full
+uint8_t I2C::put(uint8_t address, uint8_t registerAddress, const uint8_t *data, uint8_t numberBytes, uint8_t flags) {
+  uint8_t used = (flags & I2C_ZEROS) ? 0 : numberBytes;
+  uint8_t sreg;
+  uint8_t idle;
+  uint8_t err;
+  if (used > I2C_BUFFER) {
+    // too long for the buffer, send it polled
+    err = flush();
+    rate(address);
+    if (!err) err = start();
+    if (!err) err = sendAddress(SLA_W(address));
+    if (!err) err = sendByte(registerAddress);
+    for (uint8_t i = 0; (i < numberBytes) && !err; i++) {
+      err = sendByte((flags & I2C_PGM) ? pgm_read_byte(data + i) : data[i]);
+    }
+    if (!err) err = stop();
+    if (err) lose(address, registerAddress, numberBytes);
+    return(err);
+  }
+  if (waitQueue(I2C_QUEUE - 1, I2C_BUFFER - used)) {
+    lose(address, registerAddress, numberBytes);
+    return(I2C_TIMEOUT_ERR);
+  }
+  for (uint8_t i = 0; i < used; i++) {
+    buf[b_head] = (flags & I2C_PGM) ? pgm_read_byte(data + i) : data[i];
+    b_head = (b_head + 1) & (I2C_BUFFER - 1);
+  }
+  queue[q_head].address = address;
+  queue[q_head].reg = registerAddress;
+  queue[q_head].len = numberBytes;
+  queue[q_head].flags = flags;
+  q_head = (q_head + 1) & (I2C_QUEUE - 1);
+  sreg = SREG;
+  cli();
+  b_count += used;
+  q_count++;
+  idle = !busy;
+  busy = 1;
+  SREG = sreg;
+  if (idle) {
+    // start the bus, the interrupt does the rest, the TWI interrupt
+    // is off while the bus is idle so the last stop is waited for
+    // with the other interrupts on
+    if (waitStop()) return(I2C_TIMEOUT_ERR);  // the recovery dropped the queue
+    left = queue[q_tail].len;
+    rate(queue[q_tail].address);
+    TWCR = (1<<TWINT)|(1<<TWSTA)|(1<<TWEN)|(1<<TWIE);
+  }
+  return(0);
+}
+
+// wait until the queue holds at most n transactions and bytes data bytes,
+// recover the bus if the interrupt makes no progress
+uint8_t I2C::waitQueue(uint8_t n, uint8_t bytes) {
+  uint16_t t = I2C_TIMEOUT;
+  uint8_t s = steps;
+  while ((q_count > n) || (b_count > bytes)) {
+    if (s != steps) {
+      s = steps;
+      t = I2C_TIMEOUT;
+    } else if (!--t) {
+      timeouts++;
+      lockUp();
+      return(I2C_TIMEOUT_ERR);
+    }
+  }
+  return(0);
+}
+
+// wait for the TWI to finish a step
+uint8_t I2C::waitInt() {
+  uint16_t t = I2C_TIMEOUT;
+  while (!(TWCR & (1<<TWINT))) {
+    if (!--t) {
+      timeouts++;
+      lockUp();
+      return(I2C_TIMEOUT_ERR);
+    }
+  }
+  return(0);
+}
+
+// wait for the TWI to finish a stop
+uint8_t I2C::waitStop() {
+  uint16_t t = I2C_TIMEOUT;
+  while (TWCR & (1<<TWSTO)) {
+    if (!--t) {
+      timeouts++;
+      lockUp();
+      return(I2C_TIMEOUT_ERR);
+    }
+  }
+  return(0);
+}
+
 uint8_t I2C::start() {
   TWCR = (1<<TWINT)|(1<<TWSTA)|(1<<TWEN);
-  while (!(TWCR & (1<<TWINT)));
+  if (waitInt()) return(I2C_TIMEOUT_ERR);
   if ((TWI_STATUS == START) || (TWI_STATUS == REPEATED_START)) {
     return(0);
   }
-  if (TWI_STATUS == LOST_ARBTRTN) {
-    uint8_t bufferedStatus = TWI_STATUS;
-    lockUp();
-    return(bufferedStatus);
-  }
-  return(TWI_STATUS);
+  uint8_t bufferedStatus = TWI_STATUS;
+  lockUp();
+  return(bufferedStatus ? bufferedStatus : I2C_BUS_ERR);
 }
 
 uint8_t I2C::sendAddress(uint8_t i2cAddress) {
   TWDR = i2cAddress;
   TWCR = (1<<TWINT) | (1<<TWEN);
-  while (!(TWCR & (1<<TWINT)));
+  if (waitInt()) return(I2C_TIMEOUT_ERR);
   if ((TWI_STATUS == MT_SLA_ACK) || (TWI_STATUS == MR_SLA_ACK)) {
     return(0);
   }
   uint8_t bufferedStatus = TWI_STATUS;
   if ((TWI_STATUS == MT_SLA_NACK) || (TWI_STATUS == MR_SLA_NACK)) {
+    errors++;
     stop();
     return(bufferedStatus);
   } else {
     lockUp();
-    return(bufferedStatus);
+    return(bufferedStatus ? bufferedStatus : I2C_BUS_ERR);
   }
 }
 
 uint8_t I2C::sendByte(uint8_t i2cData) {
   TWDR = i2cData;
   TWCR = (1<<TWINT) | (1<<TWEN);
-  while (!(TWCR & (1<<TWINT)));
+  if (waitInt()) return(I2C_TIMEOUT_ERR);
   if (TWI_STATUS == MT_DATA_ACK) {
     return(0);
   }
   uint8_t bufferedStatus = TWI_STATUS;
   if (TWI_STATUS == MT_DATA_NACK) {
+    errors++;
     stop();
     return(bufferedStatus);
   } else {
     lockUp();
-    return(bufferedStatus);
+    return(bufferedStatus ? bufferedStatus : I2C_BUS_ERR);
   }
 }
 
-uint8_t I2C::receiveByte() {
-  TWCR = (1<<TWINT) | (1<<TWEN);
-  while (!(TWCR & (1<<TWINT)));
-  if (TWI_STATUS == LOST_ARBTRTN) {
-    uint8_t bufferedStatus = TWI_STATUS;
-    lockUp();
-    return(bufferedStatus);
+uint8_t I2C::receiveByte(uint8_t ack) {
+  if (ack) {
+    TWCR = (1<<TWINT) | (1<<TWEN) | (1<<TWEA);
+  } else {
+    TWCR = (1<<TWINT) | (1<<TWEN);
+  }
+  if (waitInt()) return(I2C_TIMEOUT_ERR);
+  if ((TWI_STATUS == MR_DATA_ACK) || (TWI_STATUS == MR_DATA_NACK)) {
+    return(0);
   }
-  return(TWI_STATUS);
+  uint8_t bufferedStatus = TWI_STATUS;
+  lockUp();
+  return(bufferedStatus ? bufferedStatus : I2C_BUS_ERR);
 }
 
 uint8_t I2C::stop() {
   TWCR = (1<<TWINT)|(1<<TWEN)| (1<<TWSTO);
-  while ((TWCR & (1<<TWSTO)));
-  return(0);
+  return(waitStop());
 }
 
+// clear and reinitialize the bus, the queued writes are dropped
+// the bus clear runs with interrupts on, so msTimer and the FSK
+// capture keep running, only the queue reset is atomic
 void I2C::lockUp() {
-  TWCR = 0; //releases SDA and SCL lines to high impedance
+  uint8_t sreg;
+  TWCR = 0; //releases SDA and SCL lines to high impedance, no TWI interrupt
+  // clock out a slave that is holding SDA low (SCL = PC5, SDA = PC4)
+  for (uint8_t i = 0; i < 9; i++) {
+    cbi(PORTC, 5);
+    sbi(DDRC, 5);
+    delayMicroseconds(5);
+    cbi(DDRC, 5);
+    sbi(PORTC, 5);
+    delayMicroseconds(5);
+  }
+  // then a stop, SDA goes high while SCL is high
+  cbi(PORTC, 4);
+  sbi(DDRC, 4);
+  delayMicroseconds(5);
+  cbi(DDRC, 4);
+  sbi(PORTC, 4);
+  delayMicroseconds(5);
+  sreg = SREG;
+  cli();
+  for (uint8_t i = 0, j = q_tail; i < q_count; i++, j = (j + 1) & (I2C_QUEUE - 1)) {
+    lose(queue[j].address, queue[j].reg, queue[j].len);
+  }
+  q_head = q_tail = q_count = 0;
+  b_head = b_tail = b_count = 0;
+  busy = 0;
+  recoveries++;
   TWCR = _BV(TWEN) | _BV(TWEA); //reinitialize TWI
+  SREG = sreg;
+}
+
+// TWI interrupt, one step of the transaction at the queue tail
+ISR(TWI_vect) {
+  I2CXfer *x = &queue[q_tail];
+  uint8_t next = 0;
+  steps++;
+  switch (TWI_STATUS) {
+    case START:
+    case REPEATED_START:
+      TWDR = SLA_W(x->address);
+      TWCR = (1<<TWINT)|(1<<TWEN)|(1<<TWIE);
+      return;
+    case MT_SLA_ACK:
+      TWDR = x->reg;
+      TWCR = (1<<TWINT)|(1<<TWEN)|(1<<TWIE);
+      return;
+    case MT_DATA_ACK:
+      if (left) {
+        left--;
+        if (x->flags & I2C_ZEROS) {
+          TWDR = 0;
+        } else {
+          TWDR = buf[b_tail];
+          b_tail = (b_tail + 1) & (I2C_BUFFER - 1);
+          b_count--;
+        }
+        TWCR = (1<<TWINT)|(1<<TWEN)|(1<<TWIE);
+        return;
+      }
+      break;
+    default:
+      // NACK or bus error, drop the rest of the transaction
+      I2C::errors++;
+      lose(x->address, x->reg, x->len);
+      if (!(x->flags & I2C_ZEROS)) {
+        b_tail = (b_tail + left) & (I2C_BUFFER - 1);
+        b_count -= left;
+      }
+      break;
+  }
+  // transaction done, stop and start the next one
+  q_tail = (q_tail + 1) & (I2C_QUEUE - 1);
+  if (--q_count) {
+    left = queue[q_tail].len;
+    rate(queue[q_tail].address);
+    next = (1<<TWSTA)|(1<<TWIE);
+  } else {
+    busy = 0;
+  }
+  TWCR = (1<<TWINT)|(1<<TWEN)|(1<<TWSTO)|next;
 }
 
 I2C I2c = I2C();
@@ -28,21 +28,64 @@
 #define cbi(sfr, bit)   (_SFR_BYTE(sfr) &= ~_BV(bit))
 #define sbi(sfr, bit)   (_SFR_BYTE(sfr) |= _BV(bit))
 
+// write queue size (powers of 2)
+#define I2C_QUEUE       8      // transactions
+#define I2C_BUFFER      64     // data bytes, longer writes are polled
+
+// SCL clock, the default for every device and the fallback rate
+#define I2C_CLOCK       400000
+
+// fastest SCL clock for the board wiring and pullups
+#ifndef I2C_MAX_CLOCK
+#define I2C_MAX_CLOCK   1000000
+#endif
+
+// devices with their own SCL clock, their dropped writes are tracked
+#define I2C_DEVICES     2
+
+// polls of TWINT or TWSTO before a bus recovery, about 1 ms at 16 MHz
+#define I2C_TIMEOUT     2000
+
+// error codes that are not a TWI status
+#define I2C_TIMEOUT_ERR 0x01   // no TWI progress, the bus was recovered
+#define I2C_BUS_ERR     0x02   // TWI bus error (status 0x00)
+#define I2C_DROPPED_ERR 0x03   // a queued write was dropped and resent
+
+// write flags
+#define I2C_PGM         0x01   // data is in flash
+#define I2C_ZEROS       0x02   // send zeros
+
 class I2C {
   public:
     I2C();
     void begin();
     void end();
-    void write(uint8_t, uint8_t, uint8_t);
-    void write(uint8_t, uint8_t, uint8_t*, uint8_t);
-    void writezeros(uint8_t, uint8_t, uint8_t);
+    void setClock(uint8_t, uint32_t);
+    uint8_t probe(uint8_t);
+    uint8_t write(uint8_t, uint8_t, uint8_t);
+    uint8_t write(uint8_t, uint8_t, uint8_t*, uint8_t);
+    uint8_t write_P(uint8_t, uint8_t, const uint8_t*, uint8_t);
+    uint8_t writezeros(uint8_t, uint8_t, uint8_t);
+    uint8_t flush();
+    uint8_t pending();
+    uint8_t dropped(uint8_t, uint8_t*, uint8_t*);
     uint8_t read(uint8_t, uint8_t);
+    uint8_t read(uint8_t, uint8_t, uint8_t*, uint8_t);
+
+    // bus health counters, errors are NACKs and bus errors
+    static volatile uint16_t timeouts;
+    static volatile uint16_t recoveries;
+    static volatile uint16_t errors;
 
   private:
+    uint8_t put(uint8_t, uint8_t, const uint8_t*, uint8_t, uint8_t);
+    uint8_t waitQueue(uint8_t, uint8_t);
+    uint8_t waitInt();
+    uint8_t waitStop();
     uint8_t start();
     uint8_t sendAddress(uint8_t);
     uint8_t sendByte(uint8_t);
-    uint8_t receiveByte();
+    uint8_t receiveByte(uint8_t);
     uint8_t stop();
     void lockUp();
 };
@@ -10,9 +10,14 @@
 #include "i2c.h"
 #include "oled.h"
 #include "font.h"
+#include "font2x.h"
 
 extern I2C i2c;
 
+#if (OLED_CHUNK % FONT_W)
+#error "OLED_CHUNK must be a multiple of FONT_W"
+#endif
+
 OLED::OLED() {
 }
 
@@ -20,8 +25,16 @@ OLED::OLED() {
 
 void OLED::begin() {
   i2c.write(OLED_ADDR, OLED_COMMAND, oled_init, sizeof(oled_init));
+  i2c.flush();
   wait(300);
-  clrScreen();
+  // clear the display RAM, the text then starts out blank
+  for (uint8_t p=0; p<8; p++) {
+    setPage(0, p);
+    sendzeros(OLED_MAXCOL);
+  }
+  memset(text, ' ', sizeof(text));
+  memset(want, ' ', sizeof(want));
+  setCursor(0,0);
 }
 
 void OLED::end() {
@@ -34,23 +47,54 @@ void OLED::wait(uint16_t x) {
   }
 }
 
-// send data
-void OLED::senddata(uint8_t data) {
-  i2c.write(OLED_ADDR, OLED_DATA, data);
+// wait for the bus to be free before queueing the next chunk,
+// so a frequency write never waits behind more than one chunk,
+// then leave the rest to the bounded flush, which recovers a hung bus
+void OLED::yield() {
+  uint16_t t = I2C_TIMEOUT;
+  while (i2c.pending()) {
+    if (idle) idle();
+    if (!--t) {
+      i2c.flush();
+      return;
+    }
+  }
 }
 
-// send zeros
-void OLED::sendzeros(uint8_t nbytes) {
-  i2c.writezeros(OLED_ADDR, OLED_DATA, nbytes);
+// send data, returns the I2C error code
+uint8_t OLED::senddata(uint8_t data) {
+  yield();
+  return i2c.write(OLED_ADDR, OLED_DATA, data);
+}
+
+// send a burst of data, returns the I2C error code
+uint8_t OLED::senddata(uint8_t *data, uint8_t nbytes) {
+  yield();
+  return i2c.write(OLED_ADDR, OLED_DATA, data, nbytes);
+}
+
+// send zeros, returns the I2C error code
+uint8_t OLED::sendzeros(uint8_t nbytes) {
+  uint8_t n;
+  uint8_t err = 0;
+  while (nbytes && !err) {
+    n = (nbytes > OLED_CHUNK) ? OLED_CHUNK : nbytes;
+    yield();
+    err = i2c.writezeros(OLED_ADDR, OLED_DATA, n);
+    nbytes -= n;
+  }
+  return err;
 }
 
 // turn off the display
 void OLED::noDisplay() {
+  yield();
   i2c.write(OLED_ADDR, OLED_COMMAND, OLED_OFF);
 }
 
 // turn on the display
 void OLED::onDisplay() {
+  yield();
   i2c.write(OLED_ADDR, OLED_COMMAND, OLED_ON);
 }
 
@@ -60,6 +104,7 @@ void OLED::setPage(uint8_t x, uint8_t y) {
   (OLED_PAGE | y),
   (0x10 | ((x & 0xf0) >> 4)),
   (x & 0x0f)};
+  yield();
   i2c.write(OLED_ADDR, OLED_COMMAND, data_arr, 3);
 }
 
@@ -70,7 +115,6 @@ void OLED::setCursor(uint8_t col, uint8_t row) {
   m_col = col;
   oledX = col*FONT_W;
   oledY = row;
-  setPage(oledX, oledY);
 }
 
 // set cursor to home
@@ -78,70 +122,152 @@ void OLED::home() {
   setCursor(0,0);
 }
 
+// the text calls below only change the wanted text and return,
+// update() sends the cells that differ from the screen
+
 // clear to end of line
 void OLED::clr2eol() {
-  sendzeros(OLED_MAXCOL - oledX);
-  for (uint8_t p=1; p<4; p++) {
-    setPage(oledX, oledY+p);
-    sendzeros(OLED_MAXCOL - oledX);
-  }
+  putstr((char *)"");
 }
 
 // clear a line
 void OLED::clrLine(uint8_t row) {
   if (row) row = 4;
-  setCursor(0,row);
-  sendzeros(OLED_MAXCOL);
-  for (uint8_t p=1; p<4; p++) {
-    setPage(oledX, oledY+p);
-    sendzeros(OLED_MAXCOL);
-  }
+  memset(layer()[row ? 1 : 0], ' ', OLED_COLS);
   setCursor(0,row);
 }
 
 // clear the screen
 void OLED::clrScreen() {
+  memset(layer(), ' ', sizeof(want));
   setCursor(0,0);
-  sendzeros(OLED_MAXCOL);
-  for (uint8_t p=1; p<8; p++) {
-    setPage(oledX, oledY+p);
-    sendzeros(OLED_MAXCOL);
+}
+
+// the text the calls write to, the screen under an overlay
+// while one is shown
+uint8_t (*OLED::layer())[OLED_COLS] {
+  return over ? under : want;
+}
+
+// show two lines over the screen until restore()
+void OLED::overlay(char *line0, char *line1) {
+  if (!over) {
+    memcpy(under, want, sizeof(want));
+    over = 1;
   }
-  setCursor(0,0);
+  post(want[0], 0, line0);
+  post(want[1], 0, line1);
+}
+
+// put back the screen under the overlay
+void OLED::restore() {
+  if (over) {
+    memcpy(want, under, sizeof(want));
+    over = 0;
+  }
+}
+
+// the char a cell shows, the font has no glyph for the rest
+uint8_t OLED::cellch(uint8_t ch) {
+  if (ch < 32 || ch > (31 + FONT2X_GLYPHS)) ch = ' ';
+  return ch;
 }
 
 // print a char
 void OLED::putch(uint8_t ch) {
-  uint8_t i, j;
-  uint8_t fx[8] = {0,0,0,0,0,0,0,0};
-  uint8_t mk = 0x01;
-  uint8_t dat;
-  if ((ch == '\n') || (oledX > (OLED_MAXCOL - FONT_W))) return;
-  if (ch < 32 || ch > 137) ch = 32;
-  // lookup the character and stretch it
-  for (i=0; i<FONT_W; i++) {
-    fx[i] = pgm_read_byte(&(font[((ch-32)*FONT_W)+i]));
-  }
-  for (j=0; j<4; j++) {
-    for (i=0; i<FONT_W; i++) {
-      dat = 0;
-      if (fx[i] & mk) dat |= 0x0f;
-      if (fx[i] & (mk<<1)) dat |= 0xf0;
-      senddata(dat);
+  if ((ch == '\n') || (m_col >= OLED_COLS)) return;
+  layer()[m_row ? 1 : 0][m_col] = cellch(ch);
+  setCursor(m_col+1, m_row);
+}
+
+// print a string and clear to end of line
+void OLED::putstr(char *str) {
+  setCursor(post(layer()[m_row ? 1 : 0], m_col, str), m_row);
+}
+
+// write a string into a text row from col and clear to end of line,
+// returns the col after the string
+uint8_t OLED::post(uint8_t *row, uint8_t col, char *str) {
+  uint8_t end = col;
+  for (; col<OLED_COLS; col++) {
+    while (*str == '\n') str++;
+    if (*str) {
+      row[col] = cellch(*str++);
+      end = col + 1;
+    } else {
+      row[col] = ' ';
     }
-    if (j<3) {
-      mk = mk<<2;
-      setPage(oledX, oledY+j+1);
+  }
+  return end;
+}
+
+// count the cells still to send
+uint8_t OLED::pending() {
+  uint8_t n = job_n;
+  for (uint8_t r=0; r<OLED_ROWS; r++) {
+    for (uint8_t c=0; c<OLED_COLS; c++) {
+      if (want[r][c] != text[r][c]) n++;
     }
   }
-  m_col++;
-  setCursor(m_col,m_row);
+  return n;
 }
 
-// print a string
-void OLED::putstr(char *str) {
-  while(*str) putch(*str++);
-  clr2eol();
+// display task, called from the main loop
+// sends one page of up to OLED_CHUNK bytes if the bus is free,
+// so it never waits and a frequency write waits for one chunk at most
+void OLED::update() {
+  uint8_t buf[OLED_CHUNK];
+  uint8_t data_arr[3];
+  uint8_t c, r, n;
+  uint8_t x, first, last;
+  if (i2c.pending()) return;
+  // a burst the bus dropped after it was queued, the writes do not
+  // say which cells it held, so send the whole screen again
+  if (i2c.dropped(OLED_ADDR, &first, &last)) {
+    memset(text, 0, sizeof(text));
+    job_err = 1;
+  }
+  if (!job_n) {
+    // find the first changed cell, and count them all for the high-water mark
+    n = 0;
+    for (r=0; r<OLED_ROWS; r++) {
+      for (c=0; c<OLED_COLS; c++) {
+        if (want[r][c] != text[r][c]) {
+          if (!n++) {
+            job_row = r;
+            job_first = c;
+          }
+        }
+      }
+    }
+    if (!n) return;
+    if (n > high_water) high_water = n;
+    // take the run from there, up to a chunk wide
+    c = job_first;
+    while ((c < OLED_COLS) && (job_n < (OLED_CHUNK/FONT_W)) &&
+           (want[job_row][c] != text[job_row][c])) {
+      job_cell[job_n++] = want[job_row][c++];
+    }
+    job_page = 0;
+    job_err = 0;
+  }
+  // one page row of the run
+  x = job_first*FONT_W;
+  data_arr[0] = OLED_PAGE | ((job_row*4) + job_page);
+  data_arr[1] = 0x10 | ((x & 0xf0) >> 4);
+  data_arr[2] = x & 0x0f;
+  for (c=0; c<job_n; c++) {
+    memcpy_P(buf+(c*FONT_W), &font2x[((job_cell[c]-32)*FONT2X_BYTES) + (job_page*FONT_W)], FONT_W);
+  }
+  job_err |= i2c.write(OLED_ADDR, OLED_COMMAND, data_arr, 3);
+  job_err |= i2c.write(OLED_ADDR, OLED_DATA, buf, job_n*FONT_W);
+  if (++job_page == 4) {
+    // the run is on the screen, or is sent again after an error
+    for (c=0; c<job_n; c++) {
+      text[job_row][job_first+c] = job_err ? 0 : job_cell[c];
+    }
+    job_n = 0;
+  }
 }
 
 // print a line
@@ -188,7 +314,7 @@ void OLED::print16(uint16_t val) {
 
 // print a 32-bit integer value
 void OLED::print32(uint32_t val) {
-  char tmp[15] = "               ";
+  char tmp[16] = "               ";
   // convert to string
   for (uint8_t i=9; val; i--) {
     if ((i==6) || (i==2)) {
@@ -15,6 +15,12 @@
 #define OLED_OFF      0xAE
 #define OLED_ON       0xAF
 #define OLED_MAXCOL   128
+#define OLED_COLS     16     // text cells per row
+#define OLED_ROWS     2      // text rows
+#define OLED_CHUNK    32     // max bytes per I2C transaction
+#ifndef OLED_CLOCK
+#define OLED_CLOCK    800000 // SCL clock, 400 kHz if the OLED fails at it
+#endif
 
 class OLED {
 
@@ -25,8 +31,10 @@ public:
   void begin();
   void end();
   void wait(uint16_t);
-  void senddata(uint8_t);
-  void sendzeros(uint8_t);
+  void yield();
+  uint8_t senddata(uint8_t);
+  uint8_t senddata(uint8_t *, uint8_t);
+  uint8_t sendzeros(uint8_t);
   void noDisplay();
   void onDisplay();
   void setPage(uint8_t, uint8_t);
@@ -35,6 +43,13 @@ public:
   void clr2eol();
   void clrLine(uint8_t);
   void clrScreen();
+  uint8_t cellch(uint8_t);
+  uint8_t post(uint8_t *, uint8_t, char *);
+  uint8_t (*layer())[OLED_COLS];
+  void overlay(char *, char *);
+  void restore();
+  uint8_t pending();
+  void update();
   void putch(uint8_t);
   void putstr(char *);
   void printline(uint8_t, char *);
@@ -48,11 +63,18 @@ public:
   uint8_t oledY;
   uint8_t m_row;
   uint8_t m_col;
-  uint8_t maddr = 1;
-  uint8_t myrow = 0;
-  uint8_t mycol = 0;
-  uint8_t fx1[10] = {0,0,0,0,0,0,0,0,0,0};
-  uint8_t fx0[10] = {0,0,0,0,0,0,0,0,0,0};
+  void (*idle)() = 0;    // called while waiting for the bus
+  uint8_t text[OLED_ROWS][OLED_COLS];  // text shadow, the cells on the screen
+  uint8_t want[OLED_ROWS][OLED_COLS];  // the cells to show
+  uint8_t under[OLED_ROWS][OLED_COLS]; // the screen under an overlay
+  uint8_t over = 0;                    // an overlay is shown
+  uint8_t high_water = 0;              // most cells waiting to be sent
+  uint8_t job_row;                     // run of cells being sent
+  uint8_t job_first;
+  uint8_t job_n = 0;
+  uint8_t job_page;
+  uint8_t job_err;
+  uint8_t job_cell[OLED_CHUNK/8];     // OLED_CHUNK/FONT_W
 
   // SSD1306 initialization commands
   const uint8_t oled_init [25] = {
@@ -0,0 +1,65 @@
+// ============================================================================
+//
+// presets.h - Si5351 Rx clock presets for the freq2band() frequencies
+//
+// generated by firmware/tools/presets.cpp, do not edit
+//
+// ============================================================================
+
+#ifndef PRESETS_H
+#define PRESETS_H
+
+#define PRESETS 47
+
+// freq, PLL freq, R div, integer mode, {p1, p2, p3}
+const struct Si5351Preset presets[PRESETS] PROGMEM = {
+  {  1840000UL, 644000000UL, 0, 1, { 44288UL,      0UL,       1UL}},  // MS 350, err 0.000 Hz
+  {  1842000UL, 736800000UL, 0, 1, { 50688UL,      0UL,       1UL}},  // MS 400, err 0.000 Hz
+  {  1836000UL, 642600000UL, 0, 1, { 44288UL,      0UL,       1UL}},  // MS 350, err 0.000 Hz
+  {  1838000UL, 735200000UL, 0, 1, { 50688UL,      0UL,       1UL}},  // MS 400, err 0.000 Hz
+  {  3573000UL, 893250000UL, 0, 1, { 31488UL,      0UL,       1UL}},  // MS 250, err 0.000 Hz
+  {  3575000UL, 893750000UL, 0, 1, { 31488UL,      0UL,       1UL}},  // MS 250, err 0.000 Hz
+  {  3578000UL, 894500000UL, 0, 1, { 31488UL,      0UL,       1UL}},  // MS 250, err 0.000 Hz
+  {  3568600UL, 892150000UL, 0, 1, { 31488UL,      0UL,       1UL}},  // MS 250, err 0.000 Hz
+  {  3570000UL, 892500000UL, 0, 1, { 31488UL,      0UL,       1UL}},  // MS 250, err 0.000 Hz
+  {  7074000UL, 707400000UL, 0, 1, { 12288UL,      0UL,       1UL}},  // MS 100, err 0.000 Hz
+  {  7047500UL, 704750000UL, 0, 1, { 12288UL,      0UL,       1UL}},  // MS 100, err 0.000 Hz
+  {  7078000UL, 707800000UL, 0, 1, { 12288UL,      0UL,       1UL}},  // MS 100, err 0.000 Hz
+  {  7038600UL, 703860000UL, 0, 1, { 12288UL,      0UL,       1UL}},  // MS 100, err 0.000 Hz
+  {  7076000UL, 707600000UL, 0, 1, { 12288UL,      0UL,       1UL}},  // MS 100, err 0.000 Hz
+  { 10136000UL, 608160000UL, 0, 1, {  7168UL,      0UL,       1UL}},  // MS 60, err 0.000 Hz
+  { 10140000UL, 608400000UL, 0, 1, {  7168UL,      0UL,       1UL}},  // MS 60, err 0.000 Hz
+  { 10130000UL, 607800000UL, 0, 1, {  7168UL,      0UL,       1UL}},  // MS 60, err 0.000 Hz
+  { 10138700UL, 811096000UL, 0, 1, {  9728UL,      0UL,       1UL}},  // MS 80, err 0.000 Hz
+  { 10138000UL, 608280000UL, 0, 1, {  7168UL,      0UL,       1UL}},  // MS 60, err 0.000 Hz
+  { 14074000UL, 703700000UL, 0, 1, {  5888UL,      0UL,       1UL}},  // MS 50, err 0.000 Hz
+  { 14080000UL, 704000000UL, 0, 1, {  5888UL,      0UL,       1UL}},  // MS 50, err 0.000 Hz
+  { 14078000UL, 703900000UL, 0, 1, {  5888UL,      0UL,       1UL}},  // MS 50, err 0.000 Hz
+  { 14095600UL, 704780000UL, 0, 1, {  5888UL,      0UL,       1UL}},  // MS 50, err 0.000 Hz
+  { 14076000UL, 703800000UL, 0, 1, {  5888UL,      0UL,       1UL}},  // MS 50, err 0.000 Hz
+  { 18100000UL, 724000000UL, 0, 1, {  4608UL,      0UL,       1UL}},  // MS 40, err 0.000 Hz
+  { 18104000UL, 724160000UL, 0, 1, {  4608UL,      0UL,       1UL}},  // MS 40, err 0.000 Hz
+  { 18104600UL, 724184000UL, 0, 1, {  4608UL,      0UL,       1UL}},  // MS 40, err 0.000 Hz
+  { 18102000UL, 724080000UL, 0, 1, {  4608UL,      0UL,       1UL}},  // MS 40, err 0.000 Hz
+  { 21074000UL, 842960000UL, 0, 1, {  4608UL,      0UL,       1UL}},  // MS 40, err 0.000 Hz
+  { 21140000UL, 634200000UL, 0, 1, {  3328UL,      0UL,       1UL}},  // MS 30, err 0.000 Hz
+  { 21078000UL, 843120000UL, 0, 1, {  4608UL,      0UL,       1UL}},  // MS 40, err 0.000 Hz
+  { 21094600UL, 843784000UL, 0, 1, {  4608UL,      0UL,       1UL}},  // MS 40, err 0.000 Hz
+  { 21076000UL, 632280000UL, 0, 1, {  3328UL,      0UL,       1UL}},  // MS 30, err 0.000 Hz
+  { 24915000UL, 747450000UL, 0, 1, {  3328UL,      0UL,       1UL}},  // MS 30, err 0.000 Hz
+  { 24919000UL, 747570000UL, 0, 1, {  3328UL,      0UL,       1UL}},  // MS 30, err 0.000 Hz
+  { 24922000UL, 747660000UL, 0, 1, {  3328UL,      0UL,       1UL}},  // MS 30, err 0.000 Hz
+  { 24924600UL, 747738000UL, 0, 1, {  3328UL,      0UL,       1UL}},  // MS 30, err 0.000 Hz
+  { 24917000UL, 747510000UL, 0, 1, {  3328UL,      0UL,       1UL}},  // MS 30, err 0.000 Hz
+  { 28074000UL, 842220000UL, 0, 1, {  3328UL,      0UL,       1UL}},  // MS 30, err 0.000 Hz
+  { 28180000UL, 845400000UL, 0, 1, {  3328UL,      0UL,       1UL}},  // MS 30, err 0.000 Hz
+  { 28078000UL, 842340000UL, 0, 1, {  3328UL,      0UL,       1UL}},  // MS 30, err 0.000 Hz
+  { 28124600UL, 843738000UL, 0, 1, {  3328UL,      0UL,       1UL}},  // MS 30, err 0.000 Hz
+  { 28076000UL, 842280000UL, 0, 1, {  3328UL,      0UL,       1UL}},  // MS 30, err 0.000 Hz
+  { 50313000UL, 805008000UL, 0, 1, {  1536UL,      0UL,       1UL}},  // MS 16, err 0.000 Hz
+  { 50318000UL, 603816000UL, 0, 1, {  1024UL,      0UL,       1UL}},  // MS 12, err 0.000 Hz
+  { 50293000UL, 804688000UL, 0, 1, {  1536UL,      0UL,       1UL}},  // MS 16, err 0.000 Hz
+  { 50310000UL, 603720000UL, 0, 1, {  1024UL,      0UL,       1UL}}   // MS 12, err 0.000 Hz
+};
+
+#endif
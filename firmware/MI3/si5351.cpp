@@ -27,11 +27,41 @@
 
 #include <stdint.h>
 #include <Arduino.h>
-#include "I2C.h"
+#include "i2c.h"
 #include "si5351.h"
 
 extern I2C i2c;
 
+// register image written by init, as runs of
+// {count, first register, data...} ending with a zero count
+static const uint8_t si5351_image[] PROGMEM = {
+  // 8pF crystal load capacitance
+  1, SI5351_CRYSTAL_LOAD, 0x92,
+  // all outputs disabled, OEB pin ignored
+  1, SI5351_OUTPUT_ENABLE_CTRL, 0xFF,
+  1, SI5351_OEB_PIN_ENABLE_CTRL, 0xFF,
+  // registers 15-65
+  51, SI5351_PLL_INPUT_SOURCE,
+  // XO input, no clock divider
+  0x00,
+  // CLK0-2 from their multisynth on PLLA, 8/2/2 mA drive
+  0x0F, 0x0C, 0x0C,
+  // CLK3-7 powered down
+  0x80, 0x80, 0x80, 0x80, 0x80,
+  // the clock disable state is low
+  0x00, 0x00,
+  // PLLA and PLLB at 800 MHz (a = 32, b = 0, c = 1)
+  0x00, 0x01, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x01, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x00,
+  // CLK0-2 multisynths cleared
+  0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  // reset the VCXO param
+  3, SI5351_VXCO_PARAMETERS_LOW, 0x00, 0x00, 0x00,
+  0
+};
+
 // Public functions
 
 void Si5351::init(void) {
@@ -43,61 +73,96 @@ void Si5351::init(void) {
   pllb_ref_osc = SI5351_PLL_INPUT_XO;
   // no clock divider
   clkin_div = SI5351_CLKIN_DIV_1;
-  // set 8pF crystal load capacitance
-  write_reg(SI5351_CRYSTAL_LOAD, 0x92);
-  // the clock disable state is low
-  write_reg(SI5351_CLK3_0_DISABLE_STATE, 0x00);
-  write_reg(SI5351_OEB_PIN_ENABLE_CTRL,  0xFF);
-  // init clocks
-  for(i = 16; i < 19; i++) write_reg(i, 0x80);
-  for(i = 16; i < 19; i++) write_reg(i, 0x0C);
-  write_reg(SI5351_OUTPUT_ENABLE_CTRL, 0xFF);
-  // set PLLA and PLLB to 800 MHz for automatic tuning
+  fast_math = SI5351_FAST_MATH;
+  pll_stale = 0;
+  update_ref();
+  // write the register image, which also loads the shadow
+  for(i = 0; i < SI5351_SHADOW_SIZE; i++) shadow[i] = 0;
+  write_image(si5351_image);
+  // the image has PLLA and PLLB at 800 MHz for automatic tuning
+  // and all clocks on PLLA
+  for(i = 0; i < 3; i++) pll_assignment[i] = SI5351_PLLA;
+  plla_freq = SI5351_PLL_FIXED;
+  pllb_freq = SI5351_PLL_FIXED;
+  pll_set = 0;
+  // write what the calibration changes
   set_pll(SI5351_PLL_FIXED, SI5351_PLLA);
   set_pll(SI5351_PLL_FIXED, SI5351_PLLB);
-  // make PLL to CLK assignments for automatic tuning
-  for(i = 0; i < 3; i++) {
-    pll_assignment[i] = SI5351_PLLA;
-    set_ms_source(i, SI5351_PLLA);
-  }
-  // reset the VCXO param
-  write_reg(SI5351_VXCO_PARAMETERS_LOW, 0);
-  write_reg(SI5351_VXCO_PARAMETERS_MID, 0);
-  write_reg(SI5351_VXCO_PARAMETERS_HIGH, 0);
   // then reset the PLLs
-  pll_reset(SI5351_PLLA);
-  pll_reset(SI5351_PLLB);
+  write_reg(SI5351_PLL_RESET, SI5351_PLL_RESET_A | SI5351_PLL_RESET_B);
 }
 
-void Si5351::set_freq(uint64_t freq, uint8_t clk) {
+// the set functions return the I2C error code of their writes, the
+// writes are queued, flush() reports the ones dropped on the bus
+
+uint8_t Si5351::set_freq(uint64_t freq, uint8_t clk) {
   struct Si5351RegSet ms_reg;
-  uint64_t pll_freq;
   uint8_t int_mode = 0;
   uint8_t div_by_4 = 0;
   uint8_t r_div = 0;
+  // calculate the synth parameters
+  r_div = calc_freq(freq, clk, &ms_reg);
+  // set multisynth registers
+  return set_ms(clk, ms_reg, int_mode, r_div, div_by_4);
+}
+
+// calculate the multisynth parameters for a clock
+// returns the R divider to use with them
+uint8_t Si5351::calc_freq(uint64_t freq, uint8_t clk, struct Si5351RegSet *ms_reg) {
+  uint8_t r_div;
   // select the proper R div value
   r_div = select_r_div(&freq);
   // calculate the synth parameters
   if (pll_assignment[clk] == SI5351_PLLA) {
-    multisynth_calc(freq, plla_freq, &ms_reg);
+    if (!fast_math || !multisynth_calc32(freq, plla_freq, ms_reg)) {
+      multisynth_calc(freq, plla_freq, ms_reg);
+    }
   } else {
-    multisynth_calc(freq, pllb_freq, &ms_reg);
+    if (!fast_math || !multisynth_calc32(freq, pllb_freq, ms_reg)) {
+      multisynth_calc(freq, pllb_freq, ms_reg);
+    }
   }
-  // set multisynth registers
-  set_ms(clk, ms_reg, int_mode, r_div, div_by_4);
+  return r_div;
 }
 
-void Si5351::set_pll(uint64_t pll_freq, uint8_t target_pll) {
+uint8_t Si5351::set_pll(uint64_t pll_freq, uint8_t target_pll) {
   struct Si5351RegSet pll_reg;
+  uint8_t mask = (1 << target_pll);
+  uint8_t err;
+  // nothing to do if the PLL is already set to this frequency
+  if (pll_set & mask) {
+    if ((target_pll == SI5351_PLLA) && (pll_freq == plla_freq)) return 0;
+    if ((target_pll == SI5351_PLLB) && (pll_freq == pllb_freq)) return 0;
+  }
+  calc_pll(pll_freq, target_pll, &pll_reg);
+  err = write_pll(target_pll, pll_reg);
   if (target_pll == SI5351_PLLA) {
-    pll_calc(SI5351_PLLA, pll_freq, &pll_reg, ref_correction[plla_ref_osc], 0);
-  } else {
-    pll_calc(SI5351_PLLB, pll_freq, &pll_reg, ref_correction[pllb_ref_osc], 0);
+    plla_freq = pll_freq;
+  } else if (target_pll == SI5351_PLLB) {
+    pllb_freq = pll_freq;
+  }
+  // a failed write is not skipped next time
+  if (!err) pll_set |= mask;
+  return err;
+}
+
+// calculate the feedback parameters for a PLL
+void Si5351::calc_pll(uint64_t pll_freq, uint8_t target_pll, struct Si5351RegSet *pll_reg) {
+  if (!fast_math || !pll_calc32(pll_ref[target_pll], pll_freq, pll_reg)) {
+    pll_calc(target_pll, pll_freq, pll_reg, 0);
   }
+}
+
+// write the feedback parameters of a PLL (no PLL reset)
+uint8_t Si5351::write_pll(uint8_t target_pll, struct Si5351RegSet pll_reg) {
   // prepare an array for parameters to be written to
   uint8_t params[20];
   uint8_t i = 0;
   uint8_t temp;
+  uint8_t err = 0;
+  uint32_t bytes = bytes_sent;
+  pll_set &= ~(1 << target_pll);
+  pll_stale &= ~(1 << target_pll);
   // registers 26-27
   temp = ((pll_reg.p3 >> 8) & 0xFF);
   params[i++] = temp;
@@ -122,28 +187,33 @@ void Si5351::set_pll(uint64_t pll_freq, uint8_t target_pll) {
   params[i++] = temp;
   // write the parameters
   if (target_pll == SI5351_PLLA) {
-    write_bulk(SI5351_PLLA_PARAMETERS, i, params);
-    plla_freq = pll_freq;
+    err = write_delta(SI5351_PLLA_PARAMETERS, i, params);
   } else if (target_pll == SI5351_PLLB) {
-    write_bulk(SI5351_PLLB_PARAMETERS, i, params);
-    pllb_freq = pll_freq;
+    err = write_delta(SI5351_PLLB_PARAMETERS, i, params);
   }
+  freq_bytes = bytes_sent - bytes;
+  return err;
 }
 
-void Si5351::set_ms(uint8_t clk, struct Si5351RegSet ms_reg, uint8_t int_mode, uint8_t r_div, uint8_t div_by_4) {
+uint8_t Si5351::set_ms(uint8_t clk, struct Si5351RegSet ms_reg, uint8_t int_mode, uint8_t r_div, uint8_t div_by_4) {
   uint8_t params[20];
   uint8_t i = 0;
   uint8_t temp;
-  uint8_t reg_val;
+  uint8_t reg_addr;
+  uint8_t err;
+  uint32_t bytes = bytes_sent;
+  if (clk > SI5351_CLK2) return 0;
+  reg_addr = SI5351_CLK0_PARAMETERS + (clk * 8);
   // registers 42-43 for CLK0
   temp = (uint8_t)((ms_reg.p3 >> 8) & 0xFF);
   params[i++] = temp;
   temp = (uint8_t)(ms_reg.p3  & 0xFF);
   params[i++] = temp;
-  // register 44 for CLK0
-  reg_val = read_reg((SI5351_CLK0_PARAMETERS + 2) + (clk * 8));
-  reg_val &= ~(0x03);
-  temp = reg_val | ((uint8_t)((ms_reg.p1 >> 16) & 0x03));
+  // register 44 for CLK0 (R divider, divide by 4, P1 bits 17-16)
+  temp = shadow[reg_addr + 2] & 0x80;
+  temp |= (r_div << SI5351_OUTPUT_CLK_DIV_SHIFT);
+  if (div_by_4) temp |= SI5351_OUTPUT_CLK_DIVBY4;
+  temp |= (uint8_t)((ms_reg.p1 >> 16) & 0x03);
   params[i++] = temp;
   // registers 45-46 for CLK0
   temp = (uint8_t)((ms_reg.p1 >> 8) & 0xFF);
@@ -159,31 +229,22 @@ void Si5351::set_ms(uint8_t clk, struct Si5351RegSet ms_reg, uint8_t int_mode, u
   params[i++] = temp;
   temp = (uint8_t)(ms_reg.p2  & 0xFF);
   params[i++] = temp;
-  // write the parameters
-  switch(clk) {
-    case SI5351_CLK0:
-      write_bulk(SI5351_CLK0_PARAMETERS, i, params);
-      set_int(clk, int_mode);
-      ms_div(clk, r_div, div_by_4);
-      break;
-    case SI5351_CLK1:
-      write_bulk(SI5351_CLK1_PARAMETERS, i, params);
-      set_int(clk, int_mode);
-      ms_div(clk, r_div, div_by_4);
-      break;
-    case SI5351_CLK2:
-      write_bulk(SI5351_CLK2_PARAMETERS, i, params);
-      set_int(clk, int_mode);
-      ms_div(clk, r_div, div_by_4);
-      break;
-    default:
-      break;
-  }
+  // write the parameters that changed
+  err = write_delta(reg_addr, i, params);
+  // change the integer mode only if needed
+  temp = (shadow[SI5351_CLK0_CTRL + clk] & SI5351_CLK_INTEGER_MODE) ? 1 : 0;
+  if (temp != int_mode) {
+    temp = set_int(clk, int_mode);
+    if (!err) err = temp;
+  }
+  freq_bytes = bytes_sent - bytes;
+  return err;
 }
 
 void Si5351::output_enable(uint8_t clk, uint8_t enable) {
   uint8_t reg_val;
-  reg_val = read_reg(SI5351_OUTPUT_ENABLE_CTRL);
+  if (enable == 1) check_pll(pll_assignment[clk]);
+  reg_val = shadow[SI5351_OUTPUT_ENABLE_CTRL];
   if (enable == 1) {
     reg_val &= ~(1<<clk);
   } else {
@@ -192,20 +253,46 @@ void Si5351::output_enable(uint8_t clk, uint8_t enable) {
   write_reg(SI5351_OUTPUT_ENABLE_CTRL, reg_val);
 }
 
+// disable one clock and enable another in one write
+uint8_t Si5351::output_switch(uint8_t off_clk, uint8_t on_clk) {
+  uint8_t reg_val;
+  check_pll(pll_assignment[on_clk]);
+  reg_val = shadow[SI5351_OUTPUT_ENABLE_CTRL];
+  reg_val |= (1<<off_clk);
+  reg_val &= ~(1<<on_clk);
+  return write_reg(SI5351_OUTPUT_ENABLE_CTRL, reg_val);
+}
+
 void Si5351::drive_strength(uint8_t clk, uint8_t drive) {
   uint8_t reg_val;
   const uint8_t mask = 0x03;
-  reg_val = read_reg(SI5351_CLK0_CTRL + clk);
+  reg_val = shadow[SI5351_CLK0_CTRL + clk];
   reg_val &= ~(mask);
   reg_val |= drive;
   write_reg(SI5351_CLK0_CTRL + clk, reg_val);
 }
 
-void Si5351::set_correction(int32_t corr, uint8_t ref_osc) {
+uint8_t Si5351::set_correction(int32_t corr, uint8_t ref_osc) {
+  uint8_t err = 0;
+  uint8_t temp;
   ref_correction[ref_osc] = corr;
-  // recalculate and set PLL freqs based on correction value
-  set_pll(plla_freq, SI5351_PLLA);
-  set_pll(pllb_freq, SI5351_PLLB);
+  update_ref();
+  // recalculate and set PLL freqs based on correction value,
+  // a PLL that feeds no enabled clock is set when it is used
+  pll_set = 0;
+  pll_stale = 0;
+  if (pll_used(SI5351_PLLA)) {
+    err = set_pll(plla_freq, SI5351_PLLA);
+  } else {
+    pll_stale |= (1 << SI5351_PLLA);
+  }
+  if (pll_used(SI5351_PLLB)) {
+    temp = set_pll(pllb_freq, SI5351_PLLB);
+    if (!err) err = temp;
+  } else {
+    pll_stale |= (1 << SI5351_PLLB);
+  }
+  return err;
 }
 
 void Si5351::pll_reset(uint8_t target_pll) {
@@ -218,7 +305,8 @@ void Si5351::pll_reset(uint8_t target_pll) {
 
 void Si5351::set_ms_source(uint8_t clk, uint8_t pll) {
   uint8_t reg_val;
-  reg_val = read_reg(SI5351_CLK0_CTRL + clk);
+  check_pll(pll);
+  reg_val = shadow[SI5351_CLK0_CTRL + clk];
   if (pll == SI5351_PLLA) {
     reg_val &= ~(SI5351_CLK_PLL_SELECT);
   } else if (pll == SI5351_PLLB) {
@@ -228,21 +316,20 @@ void Si5351::set_ms_source(uint8_t clk, uint8_t pll) {
   pll_assignment[clk] = pll;
 }
 
-void Si5351::set_int(uint8_t clk, uint8_t enable) {
+uint8_t Si5351::set_int(uint8_t clk, uint8_t enable) {
   uint8_t reg_val;
-  reg_val = read_reg(SI5351_CLK0_CTRL + clk);
+  reg_val = shadow[SI5351_CLK0_CTRL + clk];
   if (enable == 1) {
     reg_val |= (SI5351_CLK_INTEGER_MODE);
   } else {
     reg_val &= ~(SI5351_CLK_INTEGER_MODE);
   }
-  write_reg(SI5351_CLK0_CTRL + clk, reg_val);
-
+  return write_reg(SI5351_CLK0_CTRL + clk, reg_val);
 }
 
 void Si5351::set_clock_pwr(uint8_t clk, uint8_t pwr) {
   uint8_t reg_val;
-  reg_val = read_reg(SI5351_CLK0_CTRL + clk);
+  reg_val = shadow[SI5351_CLK0_CTRL + clk];
   if (pwr == 1)  {
     reg_val &= 0b01111111;
   } else {
@@ -251,34 +338,162 @@ void Si5351::set_clock_pwr(uint8_t clk, uint8_t pwr) {
   write_reg(SI5351_CLK0_CTRL + clk, reg_val);
 }
 
-void Si5351::write_bulk(uint8_t addr, uint8_t bytes, uint8_t *data) {
-  i2c.write(SI5351_I2C_ADDR, addr, data, bytes);
+// the writes and reads return the I2C error code, 0 if OK
+
+uint8_t Si5351::write_bulk(uint8_t addr, uint8_t bytes, uint8_t *data) {
+  repair();
+  for (uint8_t i = 0; i < bytes; i++) {
+    if ((addr + i) < SI5351_SHADOW_SIZE) shadow[addr + i] = data[i];
+  }
+  bytes_sent += bytes;
+  xfers++;
+  return i2c.write(SI5351_I2C_ADDR, addr, data, bytes);
+}
+
+uint8_t Si5351::write_reg(uint8_t addr, uint8_t data) {
+  repair();
+  if (addr < SI5351_SHADOW_SIZE) shadow[addr] = data;
+  bytes_sent++;
+  xfers++;
+  return i2c.write(SI5351_I2C_ADDR, addr, data);
+}
+
+// write a register image from flash, one burst per run
+void Si5351::write_image(const uint8_t *image) {
+  uint8_t bytes, addr;
+  while ((bytes = pgm_read_byte(image++)) != 0) {
+    addr = pgm_read_byte(image++);
+    for (uint8_t i = 0; i < bytes; i++) {
+      if ((addr + i) < SI5351_SHADOW_SIZE) shadow[addr + i] = pgm_read_byte(image + i);
+    }
+    i2c.write_P(SI5351_I2C_ADDR, addr, image, bytes);
+    bytes_sent += bytes;
+    xfers++;
+    image += bytes;
+  }
+}
+
+// write only the smallest run of registers that differ from the shadow
+uint8_t Si5351::write_delta(uint8_t addr, uint8_t bytes, uint8_t *data) {
+  uint8_t first = 0;
+  uint8_t last = bytes;
+  repair();
+  while ((first < last) && (shadow[addr + first] == data[first])) first++;
+  if (first == last) return 0;
+  while (shadow[addr + last - 1] == data[last - 1]) last--;
+  return write_bulk(addr + first, last - first, data + first);
+}
+
+// resend the registers of writes the I2C queue dropped, the shadow
+// has what they should be, so the deltas after it stay right
+// returns 0 if none were dropped, else the resend error code or
+// I2C_DROPPED_ERR
+uint8_t Si5351::repair(void) {
+  uint8_t first, last, err;
+  if (!i2c.dropped(SI5351_I2C_ADDR, &first, &last)) return 0;
+  if (last > SI5351_SHADOW_SIZE) last = SI5351_SHADOW_SIZE;
+  if (first >= last) return 0;
+  repairs++;
+  bytes_sent += last - first;
+  xfers++;
+  err = i2c.write(SI5351_I2C_ADDR, first, shadow + first, last - first);
+  return err ? err : I2C_DROPPED_ERR;
 }
 
-void Si5351::write_reg(uint8_t addr, uint8_t data) {
-  i2c.write(SI5351_I2C_ADDR, addr, data);
+// wait for the queued writes, returns the I2C error code, or
+// I2C_DROPPED_ERR if a write was dropped on the bus and resent
+uint8_t Si5351::flush(void) {
+  uint8_t err = i2c.flush();
+  uint8_t fix = repair();
+  return fix ? fix : err;
 }
 
 uint8_t Si5351::read_reg(uint8_t addr) {
   uint8_t reg_val = i2c.read(SI5351_I2C_ADDR, addr);
+  xfers++;
   return reg_val;
 }
 
+uint8_t Si5351::read_bulk(uint8_t addr, uint8_t bytes, uint8_t *data) {
+  xfers++;
+  return i2c.read(SI5351_I2C_ADDR, addr, data, bytes);
+}
+
+// wait for the PLLs in mask (SI5351_STATUS_LOL_A/B) to lock
+// returns the number of status reads, or 0 if it timed out
+uint8_t Si5351::wait_lock(uint8_t mask) {
+  mask |= SI5351_STATUS_SYS_INIT;
+  for (uint8_t n = 1; n <= SI5351_LOCK_TRIES; n++) {
+    if (!(read_reg(SI5351_DEVICE_STATUS) & mask)) return n;
+  }
+  return 0;
+}
+
+// compare the register shadow with the chip over the
+// registers in the init image
+// returns the number of registers that differ
+uint8_t Si5351::check_shadow(void) {
+  const uint8_t *image = si5351_image;
+  uint8_t errs = 0;
+  uint8_t bytes, addr, n;
+  uint8_t data[8];
+  shadow_err = 0;
+  while ((bytes = pgm_read_byte(image++)) != 0) {
+    addr = pgm_read_byte(image++);
+    image += bytes;
+    if ((addr + bytes) > SI5351_SHADOW_SIZE) continue;
+    // burst read the run 8 registers at a time
+    while (bytes) {
+      n = (bytes < 8) ? bytes : 8;
+      read_bulk(addr, n, data);
+      for (uint8_t i = 0; i < n; i++, addr++) {
+        if (data[i] != shadow[addr]) {
+          if (errs++ == 0) shadow_err = addr;
+        }
+      }
+      bytes -= n;
+    }
+  }
+  return errs;
+}
+
 // private functions
 
-uint64_t Si5351::pll_calc(uint8_t pll, uint64_t freq, struct Si5351RegSet *reg, int32_t corr, uint8_t vcxo) {
+// cache the reference frequency of each PLL
+void Si5351::update_ref(void) {
   uint64_t ref_freq;
-  if (pll == SI5351_PLLA) {
-    ref_freq = xtal_freq[plla_ref_osc] * SI5351_FREQ_MULT;
-  } else {
-    ref_freq = xtal_freq[pllb_ref_osc] * SI5351_FREQ_MULT;
+  int32_t corr;
+  uint8_t osc;
+  for (uint8_t pll = SI5351_PLLA; pll <= SI5351_PLLB; pll++) {
+    osc = (pll == SI5351_PLLA) ? plla_ref_osc : pllb_ref_osc;
+    ref_freq = xtal_freq[osc] * SI5351_FREQ_MULT;
+    corr = ref_correction[osc];
+    //ref_freq = 15974400ULL * SI5351_FREQ_MULT;
+    // factor calibration value into nominal crystal frequency
+    // measured in parts-per-billion
+    pll_ref[pll] = ref_freq + (int32_t)((((((int64_t)corr) << 31) / 1000000000LL) * ref_freq) >> 31);
+  }
+}
+
+// check if a PLL feeds an enabled clock
+uint8_t Si5351::pll_used(uint8_t pll) {
+  for (uint8_t clk = SI5351_CLK0; clk <= SI5351_CLK2; clk++) {
+    if (!(shadow[SI5351_OUTPUT_ENABLE_CTRL] & (1<<clk)) && (pll_assignment[clk] == pll)) return 1;
+  }
+  return 0;
+}
+
+// bring a PLL up to date with the correction before it is used
+void Si5351::check_pll(uint8_t pll) {
+  if (pll_stale & (1 << pll)) {
+    set_pll((pll == SI5351_PLLA) ? plla_freq : pllb_freq, pll);
   }
-  //ref_freq = 15974400ULL * SI5351_FREQ_MULT;
+}
+
+uint64_t Si5351::pll_calc(uint8_t pll, uint64_t freq, struct Si5351RegSet *reg, uint8_t vcxo) {
+  uint64_t ref_freq = pll_ref[pll];
   uint32_t a, b, c, p1, p2, p3;
   uint64_t lltmp;
-  // factor calibration value into nominal crystal frequency
-  // measured in parts-per-billion
-  ref_freq = ref_freq + (int32_t)((((((int64_t)corr) << 31) / 1000000000LL) * ref_freq) >> 31);
   // PLL bounds checking
   if (freq < SI5351_PLL_VCO_MIN * SI5351_FREQ_MULT) {
     freq = SI5351_PLL_VCO_MIN * SI5351_FREQ_MULT;
@@ -390,36 +605,104 @@ uint64_t Si5351::multisynth_calc(uint64_t freq, uint64_t pll_freq, struct Si5351
   }
 }
 
-void Si5351::ms_div(uint8_t clk, uint8_t r_div, uint8_t div_by_4) {
-  uint8_t reg_val = 0;
-  uint8_t reg_addr = 0;
-  switch(clk) {
-    case SI5351_CLK0:
-      reg_addr = SI5351_CLK0_PARAMETERS + 2;
-      break;
-    case SI5351_CLK1:
-      reg_addr = SI5351_CLK1_PARAMETERS + 2;
-      break;
-    case SI5351_CLK2:
-      reg_addr = SI5351_CLK2_PARAMETERS + 2;
-      break;
-    default:
-      break;
-  }
-  reg_val = read_reg(reg_addr);
-  reg_val &= ~(0x7C);
-  if (div_by_4 == 0) {
-    reg_val &= ~(SI5351_OUTPUT_CLK_DIVBY4);
-  } else {
-    reg_val |= (SI5351_OUTPUT_CLK_DIVBY4);
+// 32-bit synthesis math
+//
+// The functions below give the same register values as pll_calc and
+// multisynth_calc using only 32-bit operations. a and b are found
+// by shift-and-subtract division with a known number of quotient
+// bits and 128*b/c uses a reciprocal of 1e6. They return 0 for input
+// outside their range (e.g. 6M, where freq needs more than 32 bits)
+// and the caller falls back to the 64-bit functions.
+
+// shift the low nbits of lo into rem, dividing by den as we go
+static uint32_t div_bits(uint32_t *rem, uint32_t lo, uint8_t nbits, uint32_t den) {
+  uint32_t r = *rem;
+  uint32_t q = 0;
+  uint8_t carry;
+  while (nbits--) {
+    carry = (uint8_t)(r >> 31);
+    r = (r << 1) | ((lo >> nbits) & 1);
+    q <<= 1;
+    if (carry || (r >= den)) {
+      r -= den;
+      q |= 1;
+    }
+  }
+  *rem = r;
+  return q;
+}
+
+// b = (r * RFRAC_DENOM) / den for r < den
+static uint32_t frac_bits(uint32_t r, uint32_t den) {
+  uint32_t hi = (r >> 16) * 15625UL;
+  uint32_t lo = (r & 0xFFFF) * 15625UL;
+  // r*15625 split at bit 14, then shifted left 6 (1e6 = 15625 << 6)
+  hi = (hi << 2) + (lo >> 14);
+  return div_bits(&hi, (lo & 0x3FFF) << 6, 20, den);
+}
+
+// p1, p2 and p3 from a + b/c with c = RFRAC_DENOM (or 1 if b is 0)
+static void frac_params(uint32_t a, uint32_t b, struct Si5351RegSet *reg) {
+  const uint32_t c = RFRAC_DENOM;
+  uint32_t q;
+  int32_t r;
+  if (b == 0) {
+    reg->p1 = (128 * a) - 512;
+    reg->p2 = 0;
+    reg->p3 = 1;
+    return;
+  }
+  // q = (128 * b) / 1e6 is 2b/15625, the reciprocal can be one high
+  q = (b * 2148UL) >> 24;
+  r = (int32_t)(128 * b) - (int32_t)(c * q);
+  if (r < 0) {
+    q--;
+    r += c;
+  }
+  reg->p1 = (128 * a) + q - 512;
+  reg->p2 = r;
+  reg->p3 = c;
+}
+
+uint8_t Si5351::pll_calc32(uint64_t ref_freq, uint64_t freq, struct Si5351RegSet *reg) {
+  uint32_t ref, rem, a;
+  if (ref_freq >> 32) return 0;
+  ref = ref_freq;
+  // PLL bounds checking
+  if (freq < SI5351_PLL_VCO_MIN * SI5351_FREQ_MULT) {
+    freq = SI5351_PLL_VCO_MIN * SI5351_FREQ_MULT;
   }
-  reg_val |= (r_div << SI5351_OUTPUT_CLK_DIV_SHIFT);
-  write_reg(reg_addr, reg_val);
+  if (freq > SI5351_PLL_VCO_MAX * SI5351_FREQ_MULT) {
+    freq = SI5351_PLL_VCO_MAX * SI5351_FREQ_MULT;
+  }
+  // a has at most 7 bits
+  rem = freq >> 7;
+  if (rem >= ref) return 0;
+  a = div_bits(&rem, (uint32_t)freq & 0x7F, 7, ref);
+  if ((a < SI5351_PLL_A_MIN) || (a > SI5351_PLL_A_MAX)) return 0;
+  frac_params(a, frac_bits(rem, ref), reg);
+  return 1;
+}
+
+uint8_t Si5351::multisynth_calc32(uint64_t freq, uint64_t pll_freq, struct Si5351RegSet *reg) {
+  uint32_t f, rem, a;
+  if ((freq >> 32) || (pll_freq == 0)) return 0;
+  if ((freq > SI5351_MULTISYNTH_MAX_FREQ * SI5351_FREQ_MULT) ||
+      (freq < SI5351_MULTISYNTH_MIN_FREQ * SI5351_FREQ_MULT)) return 0;
+  f = freq;
+  // a has at most 11 bits
+  rem = pll_freq >> 11;
+  if (rem >= f) return 0;
+  a = div_bits(&rem, (uint32_t)pll_freq & 0x7FF, 11, f);
+  if ((a < SI5351_MULTISYNTH_A_MIN) || (a > SI5351_MULTISYNTH_A_MAX)) return 0;
+  frac_params(a, frac_bits(rem, f), reg);
+  return 1;
 }
 
 // select R divider
 uint8_t Si5351::select_r_div(uint64_t *freq) {
   uint8_t r_div = SI5351_OUTPUT_CLK_DIV_1;
+  if (*freq >= SI5351_CLKOUT_MIN_FREQ * SI5351_FREQ_MULT * 128) return r_div;
   if ((*freq >= SI5351_CLKOUT_MIN_FREQ * SI5351_FREQ_MULT) && (*freq < SI5351_CLKOUT_MIN_FREQ * SI5351_FREQ_MULT * 2)) {
     r_div = SI5351_OUTPUT_CLK_DIV_128;
     *freq *= 128ULL;
@@ -29,10 +29,12 @@
 #define SI5351_H_
 
 #define SI5351_I2C_ADDR                 0x60
+#define SI5351_I2C_CLOCK                400000
 #define SI5351_XTAL_FREQ                25000000
 #define SI5351_PLL_FIXED                80000000000ULL
 #define SI5351_FREQ_MULT                100ULL
 #define SI5351_DEFAULT_CLK              1000000000ULL
+#define SI5351_FAST_MATH                1
 
 #define SI5351_PLL_VCO_MIN              600000000
 #define SI5351_PLL_VCO_MAX              900000000
@@ -66,6 +68,8 @@
 #define SI5351_STATUS_LOL_B             (1<<6)
 #define SI5351_STATUS_LOL_A             (1<<5)
 #define SI5351_STATUS_LOS               (1<<4)
+// status reads before wait_lock gives up
+#define SI5351_LOCK_TRIES               100
 #define SI5351_OUTPUT_ENABLE_CTRL       3
 #define SI5351_OEB_PIN_ENABLE_CTRL      9
 #define SI5351_PLL_INPUT_SOURCE         15
@@ -123,6 +127,7 @@
 #define SI5351_CLK6_PARAMETERS          90
 #define SI5351_CLK7_PARAMETERS          91
 #define SI5351_CLK6_7_OUTPUT_DIVIDER    92
+#define SI5351_SHADOW_SIZE              (SI5351_CLK3_PARAMETERS)
 #define SI5351_OUTPUT_CLK_DIV_MASK      (7 << 4)
 #define SI5351_OUTPUT_CLK6_DIV_MASK     (7 << 0)
 #define SI5351_OUTPUT_CLK_DIV_SHIFT     4
@@ -228,24 +233,43 @@ struct Si5351RegSet {
   uint32_t p3;
 };
 
+// Rx clock settings for a dial frequency (see presets.h)
+struct Si5351Preset {
+  uint32_t freq;       // dial frequency (Hz)
+  uint32_t pll;        // PLL frequency (Hz)
+  uint8_t  r_div;
+  uint8_t  int_mode;
+  struct Si5351RegSet ms;
+};
+
 class Si5351 {
 
 public:
   // functions
   void init(void);
-  void set_freq(uint64_t, uint8_t);
-  void set_pll(uint64_t, uint8_t);
-  void set_ms(uint8_t, struct Si5351RegSet, uint8_t, uint8_t, uint8_t);
+  uint8_t set_freq(uint64_t, uint8_t);
+  uint8_t calc_freq(uint64_t, uint8_t, struct Si5351RegSet *);
+  uint8_t set_pll(uint64_t, uint8_t);
+  void calc_pll(uint64_t, uint8_t, struct Si5351RegSet *);
+  uint8_t write_pll(uint8_t, struct Si5351RegSet);
+  uint8_t set_ms(uint8_t, struct Si5351RegSet, uint8_t, uint8_t, uint8_t);
   void output_enable(uint8_t, uint8_t);
+  uint8_t output_switch(uint8_t, uint8_t);
   void drive_strength(uint8_t, uint8_t);
-  void set_correction(int32_t, uint8_t);
+  uint8_t set_correction(int32_t, uint8_t);
   void pll_reset(uint8_t);
   void set_ms_source(uint8_t, uint8_t);
-  void set_int(uint8_t, uint8_t);
+  uint8_t set_int(uint8_t, uint8_t);
   void set_clock_pwr(uint8_t, uint8_t);
-  void write_bulk(uint8_t, uint8_t, uint8_t *);
-  void write_reg(uint8_t, uint8_t);
+  uint8_t write_bulk(uint8_t, uint8_t, uint8_t *);
+  uint8_t write_delta(uint8_t, uint8_t, uint8_t *);
+  uint8_t write_reg(uint8_t, uint8_t);
   uint8_t read_reg(uint8_t);
+  uint8_t read_bulk(uint8_t, uint8_t, uint8_t *);
+  uint8_t wait_lock(uint8_t);
+  uint8_t check_shadow(void);
+  uint8_t repair(void);
+  uint8_t flush(void);
   void powerDown(void);
   // variables
   uint8_t  pll_assignment[3];
@@ -254,16 +278,35 @@ public:
   uint8_t  plla_ref_osc;
   uint8_t  pllb_ref_osc;
   uint32_t xtal_freq[2];
+  uint8_t  shadow_err;
+  uint8_t  freq_bytes;
+  uint8_t  fast_math;
+  uint32_t bytes_sent;
+  uint16_t xfers;
+  uint16_t repairs;
 
 private:
   // functions
-  uint64_t pll_calc(uint8_t, uint64_t, struct Si5351RegSet*, int32_t, uint8_t);
+  void     write_image(const uint8_t *);
+  void     update_ref(void);
+  uint8_t  pll_used(uint8_t);
+  void     check_pll(uint8_t);
+  uint64_t pll_calc(uint8_t, uint64_t, struct Si5351RegSet*, uint8_t);
   uint64_t multisynth_calc(uint64_t, uint64_t, struct Si5351RegSet*);
-  void     ms_div(uint8_t, uint8_t, uint8_t);
+  uint8_t  pll_calc32(uint64_t, uint64_t, struct Si5351RegSet*);
+  uint8_t  multisynth_calc32(uint64_t, uint64_t, struct Si5351RegSet*);
   uint8_t  select_r_div(uint64_t *);
   // variables
   int32_t ref_correction[2];
   uint8_t clkin_div;
+  // corrected reference frequency of each PLL
+  uint64_t pll_ref[2];
+  // PLLs set to plla_freq/pllb_freq, PLLs waiting for the correction
+  uint8_t pll_set;
+  uint8_t pll_stale;
+  // copy of registers 0-65 as last written, the writes the
+  // I2C queue drops are resent from it by repair()
+  uint8_t shadow[SI5351_SHADOW_SIZE];
 };
 
 #endif
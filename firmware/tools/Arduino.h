@@ -0,0 +1,21 @@
+// ============================================================================
+//
+// Arduino.h - host stand-in for the parts of the Arduino core used by
+//             the MI3 Si5351 driver, for building the tools
+//
+// ============================================================================
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define pgm_read_byte(p)   (*(const uint8_t *)(p))
+#define pgm_read_dword(p)  (*(const uint32_t *)(p))
+#define memcpy_P           memcpy
+#define _BV(bit)           (1 << (bit))
+#define _SFR_BYTE(sfr)     (sfr)
+
+#endif
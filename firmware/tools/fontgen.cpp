@@ -0,0 +1,106 @@
+// ============================================================================
+//
+// fontgen.cpp - double-height font generator for the MI3 OLED driver
+//
+// Reads the 8x8 font in font.h and writes font2x.h with every glyph
+// stretched to double height, so the OLED driver only copies bytes from
+// flash. Each font column bit becomes a nibble, and each glyph becomes
+// 4 pages of FONT_W bytes, 32 bytes per glyph in page order.
+//
+// Run it again after any change to font.h.
+//
+// build:  g++ -O2 -std=c++11 fontgen.cpp -o fontgen
+// usage:  ./fontgen ../MI3/font.h > ../MI3/font2x.h
+//
+// ============================================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#define FONT_W   8
+#define PAGES    4
+
+struct Glyph {
+  uint8_t col[FONT_W];
+  std::string name;
+};
+
+// read the glyph lines from font.h, 8 hex bytes and a comment each
+static std::vector<Glyph> read_font(const char *path) {
+  std::vector<Glyph> font;
+  std::ifstream in(path);
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t pos = line.find("0x");
+    if ((pos == std::string::npos) || (line.find("#define") != std::string::npos)) continue;
+    Glyph g;
+    uint8_t n = 0;
+    while ((n < FONT_W) && ((pos = line.find("0x", pos)) != std::string::npos)) {
+      g.col[n++] = strtoul(line.c_str() + pos, NULL, 16);
+      pos += 2;
+    }
+    if (n != FONT_W) continue;
+    pos = line.find("//");
+    if (pos != std::string::npos) {
+      g.name = line.substr(pos + 2);
+      while (!g.name.empty() && ((g.name[0] == ' ') || (g.name[0] == '\t'))) g.name.erase(0, 1);
+      while (!g.name.empty() && ((g.name.back() == '\r') || (g.name.back() == ' '))) g.name.pop_back();
+    }
+    font.push_back(g);
+  }
+  return font;
+}
+
+// one column of a glyph stretched to double height, page 0-3
+static uint8_t stretch(uint8_t col, uint8_t page) {
+  uint8_t mk = 0x01 << (page * 2);
+  uint8_t dat = 0;
+  if (col & mk) dat |= 0x0f;
+  if (col & (mk << 1)) dat |= 0xf0;
+  return dat;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s font.h > font2x.h\n", argv[0]);
+    return 1;
+  }
+  std::vector<Glyph> font = read_font(argv[1]);
+  if (font.empty()) {
+    fprintf(stderr, "no glyphs in %s\n", argv[1]);
+    return 1;
+  }
+  printf("// ============================================================================\n");
+  printf("//\n");
+  printf("// font2x.h - font.h stretched to double height for the OLED driver\n");
+  printf("//\n");
+  printf("// generated by firmware/tools/fontgen.cpp, do not edit\n");
+  printf("//\n");
+  printf("// ============================================================================\n\n");
+  printf("#ifndef FONT2X_H\n");
+  printf("#define FONT2X_H\n\n");
+  printf("#define FONT2X_BYTES  %u   // bytes per glyph, %u pages of %u\n",
+    PAGES * FONT_W, PAGES, FONT_W);
+  printf("#define FONT2X_GLYPHS %u  // from char 32\n\n", (unsigned)font.size());
+  printf("const uint8_t font2x[] PROGMEM = {\n");
+  for (size_t i = 0; i < font.size(); i++) {
+    printf("  // %s\n", font[i].name.c_str());
+    for (uint8_t p = 0; p < PAGES; p++) {
+      printf(" ");
+      for (uint8_t c = 0; c < FONT_W; c++) {
+        printf(" 0x%02x%s", stretch(font[i].col[c], p),
+          ((i + 1 == font.size()) && (p + 1 == PAGES) && (c + 1 == FONT_W)) ? "" : ",");
+      }
+      printf("\n");
+    }
+  }
+  printf("};\n\n");
+  printf("#endif\n");
+  fprintf(stderr, "%u glyphs, %u bytes\n",
+    (unsigned)font.size(), (unsigned)(font.size() * PAGES * FONT_W));
+  return 0;
+}
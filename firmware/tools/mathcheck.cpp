@@ -0,0 +1,255 @@
+// ============================================================================
+//
+// mathcheck.cpp - 32-bit against 64-bit synthesis math for the MI3 driver
+//
+// Builds the firmware Si5351 driver on the host and runs pll_calc32() and
+// multisynth_calc32() side by side with the 64-bit pll_calc() and
+// multisynth_calc() they replace. The P1/P2/P3 registers have to match
+// exactly. A case the 32-bit code hands back to the 64-bit code (it
+// returns 0) is counted as a fallback, not a mismatch.
+//
+// The PLL sweep covers reference corrections of +/-100 ppm in 10 ppm
+// steps and the whole VCO range in 750 Hz steps. The multisynth sweep
+// covers every 1 Hz step of each band on the fixed 800 MHz PLL, and
+// every 10 Hz step on PLLs from 600 to 900 MHz in 50 MHz steps.
+// Outputs above 42.9 MHz (6M) do not fit 32 bits in 1/100 Hz and
+// always fall back.
+//
+// Two passes check the 1/100 Hz fractions. The tone pass takes every
+// FSK tone the firmware can compute, dial*100 + CPUXTL/delta for each
+// capture period on each freq2band() dial frequency, through the
+// multisynth on the fixed PLL and through the PLL at the FSK divider.
+// The random pass takes seeded random 1/100 Hz outputs in the bands on
+// random PLLs, and random 1/100 Hz PLLs at random corrections.
+//
+// The calc functions are private, so the driver header is included with
+// private made public.
+//
+// build:  g++ -O2 -std=c++11 -I. -I../MI3 mathcheck.cpp ../MI3/si5351.cpp -o mathcheck
+// usage:  ./mathcheck [random cases]
+//
+// ============================================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "i2c.h"
+#define private public
+#include "si5351.h"
+#undef private
+
+// the I2C class, the math needs no chip
+
+I2C::I2C() {
+}
+
+uint8_t I2C::write(uint8_t address, uint8_t registerAddress, uint8_t data) {
+  return 0;
+}
+
+uint8_t I2C::write(uint8_t address, uint8_t registerAddress, uint8_t *data, uint8_t numberBytes) {
+  return 0;
+}
+
+uint8_t I2C::write_P(uint8_t address, uint8_t registerAddress, const uint8_t *data, uint8_t numberBytes) {
+  return 0;
+}
+
+uint8_t I2C::writezeros(uint8_t address, uint8_t registerAddress, uint8_t numberBytes) {
+  return 0;
+}
+
+uint8_t I2C::read(uint8_t address, uint8_t registerAddress) {
+  return 0;
+}
+
+uint8_t I2C::read(uint8_t address, uint8_t registerAddress, uint8_t *data, uint8_t numberBytes) {
+  return 0;
+}
+
+uint8_t I2C::flush() {
+  return 0;
+}
+
+uint8_t I2C::dropped(uint8_t address, uint8_t *first, uint8_t *last) {
+  return 0;
+}
+
+I2C i2c;
+Si5351 si5351;
+
+// the check
+
+struct Band {
+  uint32_t lo;
+  uint32_t hi;
+};
+
+// the freq2band() band limits
+static const Band bands[] = {
+  { 1800000,  2000000}, { 3500000,  4000000}, { 5300000,  5500000},
+  { 7000000,  7300000}, {10100000, 10150000}, {14000000, 14350000},
+  {18070000, 18170000}, {21000000, 21450000}, {24890000, 24990000},
+  {28000000, 29700000}, {50000000, 54000000}
+};
+
+// the freq2band() dial frequencies
+static const uint32_t dials[] = {
+  1840000, 1842000, 1836000, 1838000,
+  3573000, 3575000, 3578000, 3568600, 3570000,
+  7074000, 7047500, 7078000, 7038600, 7076000,
+  10136000, 10140000, 10130000, 10138700, 10138000,
+  14074000, 14080000, 14078000, 14095600, 14076000,
+  18100000, 18104000, 18104600, 18102000,
+  21074000, 21140000, 21078000, 21094600, 21076000,
+  24915000, 24919000, 24922000, 24924600, 24917000,
+  28074000, 28180000, 28078000, 28124600, 28076000,
+  50313000, 50318000, 50293000, 50310000
+};
+
+// the firmware FSK constants
+#define CPUXTL   1600000000ULL  // CPU clock (1/100 Hz)
+#define MAXCNT   64000          // max event period
+#define MAXTONE  3000           // highest audio tone (Hz)
+
+// the firmware fsk_divider(), the even CLK0 divider for a dial
+static uint32_t fsk_divider(uint32_t dial) {
+  uint32_t div = SI5351_PLL_VCO_MAX / (dial + MAXTONE);
+  if (div > SI5351_MULTISYNTH_A_MAX) div = SI5351_MULTISYNTH_A_MAX;
+  if (div < 8) div = 8;
+  return div & ~1;
+}
+
+// xorshift, seeded so a failure repeats
+static uint32_t seed = 2463534242UL;
+
+static uint32_t rnd() {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+// random value in lo..hi
+static uint64_t rnd_range(uint64_t lo, uint64_t hi) {
+  uint64_t r = ((uint64_t)rnd() << 32) | rnd();
+  return lo + (r % (hi - lo + 1));
+}
+
+struct Result {
+  uint32_t cases;
+  uint32_t fallbacks;
+  uint32_t mismatches;
+};
+
+static uint8_t same(Si5351RegSet *x, Si5351RegSet *y) {
+  return (x->p1 == y->p1) && (x->p2 == y->p2) && (x->p3 == y->p3);
+}
+
+static void mismatch(const char *name, uint64_t freq, uint64_t pll, Si5351RegSet *r32, Si5351RegSet *r64) {
+  printf("%s %llu on %llu: 32-bit %u %u %u  64-bit %u %u %u\n", name,
+    (unsigned long long)freq, (unsigned long long)pll,
+    r32->p1, r32->p2, r32->p3, r64->p1, r64->p2, r64->p3);
+}
+
+// one PLL case, freq in 1/100 Hz
+static void check_pll(uint64_t freq, Result *r) {
+  Si5351RegSet r32, r64;
+  r->cases++;
+  if (!si5351.pll_calc32(si5351.pll_ref[SI5351_PLLB], freq, &r32)) {
+    r->fallbacks++;
+    return;
+  }
+  si5351.pll_calc(SI5351_PLLB, freq, &r64, 0);
+  if (!same(&r32, &r64)) {
+    if (r->mismatches++ < 10) mismatch("pll", freq, si5351.pll_ref[SI5351_PLLB], &r32, &r64);
+  }
+}
+
+// one multisynth case, freq and pll in 1/100 Hz
+static void check_ms(uint64_t freq, uint64_t pll, Result *r) {
+  Si5351RegSet r32, r64;
+  r->cases++;
+  if (!si5351.multisynth_calc32(freq, pll, &r32)) {
+    r->fallbacks++;
+    return;
+  }
+  si5351.multisynth_calc(freq, pll, &r64);
+  if (!same(&r32, &r64)) {
+    if (r->mismatches++ < 10) mismatch("ms", freq, pll, &r32, &r64);
+  }
+}
+
+static void report(const char *name, Result *r) {
+  printf("%-11s %9u cases  %7u fallbacks  %u mismatches\n",
+    name, r->cases, r->fallbacks, r->mismatches);
+}
+
+int main(int argc, char **argv) {
+  uint32_t n = (argc > 1) ? atol(argv[1]) : 4000000;
+  Result pll = Result();
+  Result ms = Result();
+  Result tone_pll = Result();
+  Result tone_ms = Result();
+  Result rnd_pll = Result();
+  Result rnd_ms = Result();
+  si5351.init();
+  // the PLL sweep, every correction over the VCO range
+  for (int32_t corr = -100000; corr <= 100000; corr += 10000) {
+    si5351.set_correction(corr, SI5351_PLL_INPUT_XO);
+    for (uint64_t vco = SI5351_PLL_VCO_MIN; vco <= SI5351_PLL_VCO_MAX; vco += 750) {
+      check_pll(vco * SI5351_FREQ_MULT, &pll);
+    }
+  }
+  // the multisynth sweep, the bands on the fixed PLL
+  for (size_t i = 0; i < sizeof(bands) / sizeof(bands[0]); i++) {
+    for (uint64_t freq = bands[i].lo; freq <= bands[i].hi; freq++) {
+      check_ms(freq * SI5351_FREQ_MULT, SI5351_PLL_FIXED, &ms);
+    }
+  }
+  // and across the VCO range
+  for (uint64_t vco = SI5351_PLL_VCO_MIN; vco <= SI5351_PLL_VCO_MAX; vco += 50000000) {
+    for (size_t i = 0; i < sizeof(bands) / sizeof(bands[0]); i++) {
+      for (uint64_t freq = bands[i].lo; freq <= bands[i].hi; freq += 10) {
+        check_ms(freq * SI5351_FREQ_MULT, vco * SI5351_FREQ_MULT, &ms);
+      }
+    }
+  }
+  // the FSK tones, every capture period on each dial
+  si5351.set_correction(0, SI5351_PLL_INPUT_XO);
+  for (size_t i = 0; i < sizeof(dials) / sizeof(dials[0]); i++) {
+    uint64_t div = fsk_divider(dials[i]);
+    for (uint32_t delta = CPUXTL / 100 / MAXTONE; delta < MAXCNT; delta++) {
+      uint64_t tone = ((uint64_t)dials[i] * 100) + (CPUXTL / delta);
+      check_ms(tone, SI5351_PLL_FIXED, &tone_ms);
+      check_pll(tone * div, &tone_pll);
+    }
+  }
+  // random 1/100 Hz outputs in the bands on random PLLs
+  for (uint32_t k = 0; k < n; k++) {
+    const Band *b = &bands[rnd() % (sizeof(bands) / sizeof(bands[0]))];
+    uint64_t freq = rnd_range((uint64_t)b->lo * SI5351_FREQ_MULT, (uint64_t)b->hi * SI5351_FREQ_MULT);
+    uint64_t vco = rnd_range((uint64_t)SI5351_PLL_VCO_MIN * SI5351_FREQ_MULT,
+                             (uint64_t)SI5351_PLL_VCO_MAX * SI5351_FREQ_MULT);
+    check_ms(freq, vco, &rnd_ms);
+  }
+  // and random 1/100 Hz PLLs at random corrections
+  for (uint32_t k = 0; k < n; k++) {
+    if (!(k & 1023)) si5351.set_correction((int32_t)rnd_range(0, 200000) - 100000, SI5351_PLL_INPUT_XO);
+    check_pll(rnd_range((uint64_t)SI5351_PLL_VCO_MIN * SI5351_FREQ_MULT,
+                        (uint64_t)SI5351_PLL_VCO_MAX * SI5351_FREQ_MULT), &rnd_pll);
+  }
+  report("pll", &pll);
+  report("multisynth", &ms);
+  report("tone pll", &tone_pll);
+  report("tone ms", &tone_ms);
+  report("random pll", &rnd_pll);
+  report("random ms", &rnd_ms);
+  if (pll.mismatches || ms.mismatches || tone_pll.mismatches || tone_ms.mismatches ||
+      rnd_pll.mismatches || rnd_ms.mismatches) {
+    printf("FAIL\n");
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
@@ -0,0 +1,101 @@
+// ============================================================================
+//
+// oledbench.cpp - I2C traffic count for the MI3 OLED driver
+//
+// Builds the firmware OLED driver on the host against an I2C class that
+// counts the transactions and bytes it is asked to send, and estimates
+// the bus time at the OLED SCL clock. Each transaction costs a start,
+// the address, the control byte, the data and a stop, 9 bits per byte.
+//
+// The text calls only post the text, the display task sends it.
+//
+// The draw_freq() case is the mode/band/freq redraw the sketch does on
+// every update_freq(), the mode line and the frequency, here for a
+// 100 Hz retune. The OLED driver only sends the cells that changed.
+//
+// build:  g++ -O2 -std=c++11 -fpermissive -w -I. -I../MI3 oledbench.cpp ../MI3/oled.cpp -o oledbench
+// usage:  ./oledbench
+//
+// ============================================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include "i2c.h"
+#include "oled.h"
+
+// the counting I2C
+
+static uint32_t xfers;
+static uint32_t bytes;
+
+static void count(uint8_t n) {
+  xfers++;
+  bytes += n;
+}
+
+I2C::I2C() {
+}
+
+uint8_t I2C::write(uint8_t address, uint8_t registerAddress, uint8_t data) {
+  count(1);
+  return 0;
+}
+
+uint8_t I2C::write(uint8_t address, uint8_t registerAddress, uint8_t *data, uint8_t numberBytes) {
+  count(numberBytes);
+  return 0;
+}
+
+uint8_t I2C::writezeros(uint8_t address, uint8_t registerAddress, uint8_t numberBytes) {
+  count(numberBytes);
+  return 0;
+}
+
+uint8_t I2C::pending() {
+  return 0;
+}
+
+uint8_t I2C::flush() {
+  return 0;
+}
+
+I2C i2c;
+OLED oled;
+
+// the bench
+
+// run the display task until the screen is up to date
+static void drain() {
+  while (oled.pending()) oled.update();
+}
+
+static void report(const char *name) {
+  drain();
+  // start + address + control + data + stop
+  double bits = xfers * (2 + 2 * 9) + bytes * 9.0;
+  printf("%-12s %5u xfers  %5u bytes  %7.2f ms at %u kHz\n",
+    name, xfers, bytes, bits * 1000.0 / OLED_CLOCK, OLED_CLOCK / 1000);
+  xfers = 0;
+  bytes = 0;
+}
+
+int main() {
+  char mode[] = "FT8  20M   12.5V";
+  oled.begin();
+  report("begin");
+  oled.printline(0, mode);
+  oled.printline(1, mode);
+  drain();
+  xfers = 0;
+  bytes = 0;
+  oled.clrScreen();
+  report("clrScreen");
+  oled.printline(0, mode);
+  report("printline");
+  oled.print32(14074000);
+  report("print32");
+  oled.printline(0, mode);
+  oled.print32(14074100);
+  report("draw_freq");
+  return 0;
+}
@@ -0,0 +1,223 @@
+// ============================================================================
+//
+// presets.cpp - Si5351 preset table generator for the ADX-MI3
+//
+// Searches every PLL frequency the Si5351 driver can set exactly, every
+// multisynth divider and every R divider for each dial frequency known to
+// freq2band() in ADX_MI3.ino, and writes presets.h with the best Rx clock
+// settings for each one.
+//
+// The best setting has the lowest frequency error, then an even integer
+// multisynth (integer mode), then the simplest PLL fraction, then the
+// smallest R divider. The error is for the nominal 25 MHz crystal, the
+// firmware applies the calibration when it sets the PLL.
+//
+// build:  g++ -O2 -std=c++11 -pthread presets.cpp -o presets
+// usage:  ./presets ../MI3/ADX_MI3.ino > ../MI3/presets.h
+//
+// ============================================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// these match si5351.h
+#define XTAL_FREQ       25000000ULL
+#define RFRAC_DENOM     1000000ULL
+#define PLL_VCO_MIN     600000000ULL
+#define PLL_VCO_MAX     900000000ULL
+#define MS_A_MIN        6
+#define MS_A_MAX        1800
+#define R_DIVS          8
+
+// the driver sets the PLL fraction in steps of XTAL_FREQ/RFRAC_DENOM,
+// so the PLL frequencies on this grid are set without error
+#define PLL_STEP        (XTAL_FREQ / RFRAC_DENOM)
+
+// PLL steps searched by one job
+#define CHUNK           250000
+
+struct Preset {
+  uint32_t freq;       // dial frequency (Hz)
+  uint32_t pll;        // PLL frequency (Hz)
+  uint8_t  r_div;      // R divider (log2)
+  uint8_t  int_mode;   // even integer multisynth
+  uint32_t a, b, c;    // multisynth divider a + b/c
+  uint32_t pll_den;    // reduced PLL fraction denominator
+  double   err;        // frequency error (Hz)
+  uint8_t  valid;
+};
+
+static uint64_t gcd(uint64_t x, uint64_t y) {
+  while (y) {
+    uint64_t t = x % y;
+    x = y;
+    y = t;
+  }
+  return x;
+}
+
+// true if p is a better preset than q
+static bool better(const Preset &p, const Preset &q) {
+  if (!q.valid) return p.valid;
+  if (!p.valid) return false;
+  if (fabs(p.err) < fabs(q.err) - 1e-9) return true;
+  if (fabs(p.err) > fabs(q.err) + 1e-9) return false;
+  if (p.int_mode != q.int_mode) return p.int_mode;
+  if (p.pll_den != q.pll_den) return p.pll_den < q.pll_den;
+  if (p.r_div != q.r_div) return p.r_div < q.r_div;
+  return p.pll < q.pll;
+}
+
+// scan PLL steps k..kend with one R divider and keep the best
+// multisynth the driver would set for them
+static void scan(uint32_t freq, uint8_t r_div, uint64_t k, uint64_t kend, Preset *best) {
+  Preset p;
+  uint64_t f = (uint64_t)freq << r_div;
+  uint64_t pll = PLL_VCO_MIN + k * PLL_STEP;
+  // the multisynth divider is a + rem/f, stepped along with the PLL
+  uint64_t a = pll / f;
+  uint64_t rem = pll % f;
+  uint64_t b, c, num, den, pf;
+  for (; k < kend; k++, pll += PLL_STEP, rem += PLL_STEP) {
+    while (rem >= f) {
+      rem -= f;
+      a++;
+    }
+    if ((a < MS_A_MIN) || (a > MS_A_MAX)) continue;
+    // b/c is rem/f rounded down, the error is what it drops
+    b = (rem * RFRAC_DENOM) / f;
+    c = b ? RFRAC_DENOM : 1;
+    num = b ? (rem * RFRAC_DENOM) - (b * f) : rem;
+    den = a * c + b;
+    p.err = (double)num / (double)(den << r_div);
+    if (best->valid && (p.err > fabs(best->err) + 1e-9)) continue;
+    pf = (pll / PLL_STEP) % RFRAC_DENOM;
+    p.freq = freq;
+    p.pll = (uint32_t)pll;
+    p.r_div = r_div;
+    p.int_mode = ((b == 0) && !(a & 1)) ? 1 : 0;
+    p.a = (uint32_t)a;
+    p.b = (uint32_t)b;
+    p.c = (uint32_t)c;
+    p.pll_den = pf ? (uint32_t)(RFRAC_DENOM / gcd(pf, RFRAC_DENOM)) : 1;
+    p.valid = 1;
+    if (better(p, *best)) *best = p;
+  }
+}
+
+// read the dial frequencies from freq2band() in the sketch
+static std::vector<uint32_t> read_freqs(const char *path) {
+  std::vector<uint32_t> freqs;
+  std::ifstream in(path);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  std::string src = ss.str();
+  size_t pos = src.find("uint8_t freq2band(uint32_t freq) {");
+  if (pos == std::string::npos) return freqs;
+  size_t end = src.find("\n}", pos);
+  std::string body = src.substr(pos, end - pos);
+  // drop the comments
+  std::string code;
+  for (size_t i = 0; i < body.size(); i++) {
+    if (body.compare(i, 2, "/*") == 0) {
+      i = body.find("*/", i);
+      if (i == std::string::npos) break;
+      i++;
+    } else if (body.compare(i, 2, "//") == 0) {
+      i = body.find('\n', i);
+      if (i == std::string::npos) break;
+    } else {
+      code += body[i];
+    }
+  }
+  pos = 0;
+  while ((pos = code.find("case ", pos)) != std::string::npos) {
+    pos += 5;
+    freqs.push_back(strtoul(code.c_str() + pos, NULL, 10));
+  }
+  return freqs;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s ADX_MI3.ino > presets.h\n", argv[0]);
+    return 1;
+  }
+  std::vector<uint32_t> freqs = read_freqs(argv[1]);
+  if (freqs.empty()) {
+    fprintf(stderr, "no freq2band() frequencies in %s\n", argv[1]);
+    return 1;
+  }
+  // one job is one frequency and one chunk of PLL steps
+  const uint64_t steps = (PLL_VCO_MAX - PLL_VCO_MIN) / PLL_STEP + 1;
+  const uint32_t chunks = (steps + CHUNK - 1) / CHUNK;
+  const uint32_t jobs = freqs.size() * chunks;
+  Preset none = Preset();
+  std::vector<Preset> result(jobs);
+  std::atomic<uint32_t> next(0);
+  unsigned nthreads = std::thread::hardware_concurrency();
+  if (nthreads == 0) nthreads = 1;
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < nthreads; t++) {
+    workers.push_back(std::thread([&]() {
+      uint32_t job;
+      while ((job = next++) < jobs) {
+        uint32_t freq = freqs[job / chunks];
+        uint64_t k = (uint64_t)(job % chunks) * CHUNK;
+        uint64_t kend = k + CHUNK;
+        if (kend > steps) kend = steps;
+        Preset best = none;
+        for (uint8_t r_div = 0; r_div < R_DIVS; r_div++) {
+          // skip the R dividers that leave the multisynth out of range
+          if (((uint64_t)freq << r_div) * MS_A_MIN > PLL_VCO_MAX) break;
+          scan(freq, r_div, k, kend, &best);
+        }
+        result[job] = best;
+      }
+    }));
+  }
+  for (unsigned t = 0; t < nthreads; t++) workers[t].join();
+  // write the header
+  printf("// ============================================================================\n");
+  printf("//\n");
+  printf("// presets.h - Si5351 Rx clock presets for the freq2band() frequencies\n");
+  printf("//\n");
+  printf("// generated by firmware/tools/presets.cpp, do not edit\n");
+  printf("//\n");
+  printf("// ============================================================================\n\n");
+  printf("#ifndef PRESETS_H\n");
+  printf("#define PRESETS_H\n\n");
+  printf("#define PRESETS %u\n\n", (unsigned)freqs.size());
+  printf("// freq, PLL freq, R div, integer mode, {p1, p2, p3}\n");
+  printf("const struct Si5351Preset presets[PRESETS] PROGMEM = {\n");
+  double max_err = 0;
+  for (size_t i = 0; i < freqs.size(); i++) {
+    Preset best = none;
+    for (uint32_t j = 0; j < chunks; j++) {
+      if (better(result[i * chunks + j], best)) best = result[i * chunks + j];
+    }
+    if (!best.valid) {
+      fprintf(stderr, "no preset for %u Hz\n", freqs[i]);
+      return 1;
+    }
+    if (fabs(best.err) > max_err) max_err = fabs(best.err);
+    uint32_t p1 = 128 * best.a + ((128 * best.b) / best.c) - 512;
+    uint32_t p2 = 128 * best.b - best.c * ((128 * best.b) / best.c);
+    printf("  {%9uUL, %9uUL, %u, %u, {%6uUL, %6uUL, %7uUL}}%s  // MS %u%s, err %.3f Hz\n",
+      best.freq, best.pll, best.r_div, best.int_mode, p1, p2, best.c,
+      (i + 1 < freqs.size()) ? "," : " ", best.a, best.b ? "+frac" : "", best.err);
+  }
+  printf("};\n\n");
+  printf("#endif\n");
+  fprintf(stderr, "%u presets, %u threads, max error %.3f Hz\n",
+    (unsigned)freqs.size(), nthreads, max_err);
+  return 0;
+}
@@ -0,0 +1,204 @@
+// ============================================================================
+//
+// sweep.cpp - Si5351 device model and accuracy sweep for the MI3 driver
+//
+// Builds the firmware Si5351 driver on the host against a model of the
+// chip. The model takes the register writes the driver sends through the
+// I2C class and decodes the PLL, multisynth and R divider state back into
+// the exact output frequency.
+//
+// The sweep runs set_freq on CLK1 for every 1 Hz step across each band
+// and on CLK0 for every 1 Hz audio tone from 200 to 3000 Hz above each
+// freq2band() dial frequency. It reports the maximum error, the calls
+// per second and the bytes per call, and fails when the error is over
+// the limit. The default limit is 4 Hz, since the driver truncates the
+// multisynth fraction to 1/1000000, which is up to 3.6 Hz on 6M.
+//
+// build:  g++ -O2 -std=c++11 -I. -I../MI3 sweep.cpp ../MI3/si5351.cpp -o sweep
+// usage:  ./sweep [max error in Hz]
+//
+// ============================================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include "i2c.h"
+#include "si5351.h"
+
+// the Si5351 model
+
+#define XTAL_FREQ  25000000.0L
+
+static uint8_t regs[256];
+static uint32_t xfers;
+
+I2C::I2C() {
+}
+
+uint8_t I2C::write(uint8_t address, uint8_t registerAddress, uint8_t data) {
+  regs[registerAddress] = data;
+  xfers++;
+  return 0;
+}
+
+uint8_t I2C::write(uint8_t address, uint8_t registerAddress, uint8_t *data, uint8_t numberBytes) {
+  for (uint8_t i = 0; i < numberBytes; i++) regs[(uint8_t)(registerAddress + i)] = data[i];
+  xfers++;
+  return 0;
+}
+
+uint8_t I2C::write_P(uint8_t address, uint8_t registerAddress, const uint8_t *data, uint8_t numberBytes) {
+  for (uint8_t i = 0; i < numberBytes; i++) regs[(uint8_t)(registerAddress + i)] = data[i];
+  xfers++;
+  return 0;
+}
+
+uint8_t I2C::writezeros(uint8_t address, uint8_t registerAddress, uint8_t numberBytes) {
+  for (uint8_t i = 0; i < numberBytes; i++) regs[(uint8_t)(registerAddress + i)] = 0;
+  xfers++;
+  return 0;
+}
+
+uint8_t I2C::read(uint8_t address, uint8_t registerAddress) {
+  xfers++;
+  return regs[registerAddress];
+}
+
+uint8_t I2C::read(uint8_t address, uint8_t registerAddress, uint8_t *data, uint8_t numberBytes) {
+  for (uint8_t i = 0; i < numberBytes; i++) data[i] = regs[(uint8_t)(registerAddress + i)];
+  xfers++;
+  return 0;
+}
+
+uint8_t I2C::flush() {
+  return 0;
+}
+
+uint8_t I2C::dropped(uint8_t address, uint8_t *first, uint8_t *last) {
+  return 0;
+}
+
+I2C i2c;
+Si5351 si5351;
+
+// divider a + b/c from the P1/P2/P3 registers at addr
+static long double divider(uint8_t addr) {
+  uint32_t p1, p2, p3;
+  p3 = ((uint32_t)(regs[addr + 5] & 0xF0) << 12) | (regs[addr] << 8) | regs[addr + 1];
+  p1 = ((uint32_t)(regs[addr + 2] & 0x03) << 16) | (regs[addr + 3] << 8) | regs[addr + 4];
+  p2 = ((uint32_t)(regs[addr + 5] & 0x0F) << 16) | (regs[addr + 6] << 8) | regs[addr + 7];
+  if (p3 == 0) return 0;
+  return ((long double)p1 + 512.0L + (long double)p2 / p3) / 128.0L;
+}
+
+// output frequency of a clock (Hz)
+static long double clk_freq(uint8_t clk) {
+  uint8_t ms = SI5351_CLK0_PARAMETERS + 8 * clk;
+  uint8_t pll = (regs[SI5351_CLK0_CTRL + clk] & 0x20) ? SI5351_PLLB_PARAMETERS : SI5351_PLLA_PARAMETERS;
+  long double vco = XTAL_FREQ * divider(pll);
+  long double div;
+  if ((regs[ms + 2] & 0x0C) == 0x0C) {
+    div = 4;
+  } else {
+    div = divider(ms);
+  }
+  if (div == 0) return 0;
+  return vco / div / (1 << ((regs[ms + 2] >> 4) & 0x07));
+}
+
+// the sweep
+
+struct Band {
+  uint32_t lo;
+  uint32_t hi;
+};
+
+// the freq2band() band limits
+static const Band bands[] = {
+  { 1800000,  2000000}, { 3500000,  4000000}, { 5300000,  5500000},
+  { 7000000,  7300000}, {10100000, 10150000}, {14000000, 14350000},
+  {18070000, 18170000}, {21000000, 21450000}, {24890000, 24990000},
+  {28000000, 29700000}, {50000000, 54000000}
+};
+
+// the freq2band() dial frequencies
+static const uint32_t dials[] = {
+  1840000, 1842000, 1836000, 1838000,
+  3573000, 3575000, 3578000, 3568600, 3570000,
+  7074000, 7047500, 7078000, 7038600, 7076000,
+  10136000, 10140000, 10130000, 10138700, 10138000,
+  14074000, 14080000, 14078000, 14095600, 14076000,
+  18100000, 18104000, 18104600, 18102000,
+  21074000, 21140000, 21078000, 21094600, 21076000,
+  24915000, 24919000, 24922000, 24924600, 24917000,
+  28074000, 28180000, 28078000, 28124600, 28076000,
+  50313000, 50318000, 50293000, 50310000
+};
+
+struct Result {
+  uint32_t calls;
+  uint64_t bytes;
+  uint32_t xfers;
+  double   max_err;
+  uint32_t max_freq;
+  double   secs;
+};
+
+static void run(uint8_t clk, uint32_t freq, Result *r) {
+  long double err;
+  si5351.set_freq((uint64_t)freq * 100, clk);
+  err = fabsl(clk_freq(clk) - freq);
+  if (err > r->max_err) {
+    r->max_err = err;
+    r->max_freq = freq;
+  }
+  r->calls++;
+}
+
+static void report(const char *name, Result *r) {
+  printf("%-6s %9u calls  max error %.4f Hz at %u Hz  %.0f calls/s  %.2f bytes/call  %.2f xfers/call\n",
+    name, r->calls, r->max_err, r->max_freq, r->calls / r->secs,
+    (double)r->bytes / r->calls, (double)r->xfers / r->calls);
+}
+
+int main(int argc, char **argv) {
+  double limit = (argc > 1) ? atof(argv[1]) : 4.0;
+  Result band = Result();
+  Result tones = Result();
+  si5351.init();
+  // the band sweep on the Rx clock
+  uint32_t bytes = si5351.bytes_sent;
+  xfers = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < sizeof(bands) / sizeof(bands[0]); i++) {
+    for (uint32_t freq = bands[i].lo; freq <= bands[i].hi; freq++) run(SI5351_CLK1, freq, &band);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  band.secs = std::chrono::duration<double>(t1 - t0).count();
+  band.bytes = si5351.bytes_sent - bytes;
+  band.xfers = xfers;
+  // the tone sweep on the Tx clock
+  bytes = si5351.bytes_sent;
+  xfers = 0;
+  t0 = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < sizeof(dials) / sizeof(dials[0]); i++) {
+    for (uint32_t tone = 200; tone <= 3000; tone++) run(SI5351_CLK0, dials[i] + tone, &tones);
+  }
+  t1 = std::chrono::steady_clock::now();
+  tones.secs = std::chrono::duration<double>(t1 - t0).count();
+  tones.bytes = si5351.bytes_sent - bytes;
+  tones.xfers = xfers;
+  report("bands", &band);
+  report("tones", &tones);
+  // the driver shadow has to match the model
+  uint8_t errs = si5351.check_shadow();
+  if (errs) printf("shadow: %u registers differ, first %u\n", errs, si5351.shadow_err);
+  if ((band.max_err > limit) || (tones.max_err > limit) || errs) {
+    printf("FAIL (limit %.4f Hz)\n", limit);
+    return 1;
+  }
+  printf("PASS (limit %.4f Hz)\n", limit);
+  return 0;
+}